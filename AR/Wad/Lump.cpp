@@ -18,6 +18,7 @@
 #include "Core/File.hpp"
 #include "Core/Path.hpp"
 
+#include <sstream>
 #include <string>
 
 
@@ -46,6 +47,48 @@ namespace GDCC::AR::Wad
       ListUtil::Unlink(this);
    }
 
+   //
+   // Lump::genHash
+   //
+   std::size_t Lump::genHash() const
+   {
+      std::unique_ptr<Core::FileBlock> block;
+      if(auto data = getData(block))
+         return Core::StrHash(data, sizeData());
+
+      std::ostringstream out;
+      writeData(out);
+      auto str = out.str();
+      return Core::StrHash(str.data(), str.size());
+   }
+
+   //
+   // Lump::getData
+   //
+   char const *Lump::getData(std::unique_ptr<Core::FileBlock> &) const
+   {
+      return nullptr;
+   }
+
+   //
+   // Lump::getHash
+   //
+   std::size_t Lump::getHash() const
+   {
+      if(!cacheHash)
+         cacheHash = genHash();
+
+      return cacheHash;
+   }
+
+   //
+   // Lump::getHead
+   //
+   void Lump::getHead(std::vector<Lump const *> &heads) const
+   {
+      heads.push_back(this);
+   }
+
    //
    // Lump::sizeHead
    //
@@ -98,6 +141,14 @@ namespace GDCC::AR::Wad
    {
    }
 
+   //
+   // Lump_Data::getData
+   //
+   char const *Lump_Data::getData(std::unique_ptr<Core::FileBlock> &) const
+   {
+      return data.get();
+   }
+
    //
    // Lump_Data::sizeData
    //
@@ -114,6 +165,14 @@ namespace GDCC::AR::Wad
       out.write(data.get(), size);
    }
 
+   //
+   // Lump_Empty::getData
+   //
+   char const *Lump_Empty::getData(std::unique_ptr<Core::FileBlock> &) const
+   {
+      return "";
+   }
+
    //
    // Lump_Empty::sizeData
    //
@@ -139,6 +198,23 @@ namespace GDCC::AR::Wad
    {
    }
 
+   //
+   // Lump_File::genHash
+   //
+   std::size_t Lump_File::genHash() const
+   {
+      return Core::FileOpenBlock(file.get())->getHash();
+   }
+
+   //
+   // Lump_File::getData
+   //
+   char const *Lump_File::getData(std::unique_ptr<Core::FileBlock> &block) const
+   {
+      block = Core::FileOpenBlock(file.get());
+      return block->data();
+   }
+
    //
    // Lump_File::sizeData
    //
@@ -152,9 +228,10 @@ namespace GDCC::AR::Wad
    //
    void Lump_File::writeData(std::ostream &out) const
    {
-      auto in = Core::FileOpenStream(file.get(), std::ios_base::in | std::ios_base::binary);
-      for(int c; (c = in->sbumpc()) != EOF;)
-         out.put(c);
+      // The block is mapped where possible, with read as the fallback, so the
+      // contents are passed to the output in a single write.
+      auto block = Core::FileOpenBlock(file.get());
+      out.write(block->data(), block->size());
    }
 
    //
@@ -176,6 +253,14 @@ namespace GDCC::AR::Wad
    {
    }
 
+   //
+   // Lump_FilePart::getData
+   //
+   char const *Lump_FilePart::getData(std::unique_ptr<Core::FileBlock> &) const
+   {
+      return data;
+   }
+
    //
    // Lump_FilePart::sizeData
    //
@@ -19,6 +19,7 @@
 #include "../../Core/String.hpp"
 
 #include <ostream>
+#include <vector>
 
 
 //----------------------------------------------------------------------------|
@@ -39,6 +40,19 @@ namespace GDCC::AR::Wad
 
       Lump &operator = (Lump const &) = delete;
 
+      // getData
+      // Returns the contents of the lump, or null if they are not stored
+      // contiguously. If needed to access the data, block is set.
+      virtual char const *getData(std::unique_ptr<Core::FileBlock> &block) const;
+
+      // getHash
+      // Returns a hash of the lump's contents, computed once.
+      std::size_t getHash() const;
+
+      // getHead
+      // Appends the lumps that get a header entry for this lump.
+      virtual void getHead(std::vector<Lump const *> &heads) const;
+
       virtual std::size_t sizeData() const = 0;
       virtual std::size_t sizeHead() const;
 
@@ -50,8 +64,15 @@ namespace GDCC::AR::Wad
       Lump *wadNext, *wadPrev;
       Core::String name;
 
+   protected:
+      // genHash
+      // Computes the hash returned by getHash.
+      virtual std::size_t genHash() const;
+
    private:
       using ListUtil = Core::ListUtil<Lump, &Lump::wadPrev, &Lump::wadNext>;
+
+      mutable std::size_t cacheHash = 0;
    };
 
    //
@@ -62,6 +83,8 @@ namespace GDCC::AR::Wad
    public:
       Lump_Data(Core::String name, std::unique_ptr<char[]> &&data, std::size_t size);
 
+      virtual char const *getData(std::unique_ptr<Core::FileBlock> &block) const;
+
       virtual std::size_t sizeData() const;
 
       virtual void writeData(std::ostream &out) const;
@@ -79,6 +102,8 @@ namespace GDCC::AR::Wad
    public:
       using Lump::Lump;
 
+      virtual char const *getData(std::unique_ptr<Core::FileBlock> &block) const;
+
       virtual std::size_t sizeData() const;
 
       virtual void writeData(std::ostream &out) const;
@@ -92,10 +117,15 @@ namespace GDCC::AR::Wad
    public:
       Lump_File(Core::String name, std::unique_ptr<char[]> &&file);
 
+      virtual char const *getData(std::unique_ptr<Core::FileBlock> &block) const;
+
       virtual std::size_t sizeData() const;
 
       virtual void writeData(std::ostream &out) const;
 
+   protected:
+      virtual std::size_t genHash() const;
+
    private:
       std::unique_ptr<char[]> file;
       std::size_t             size;
@@ -111,6 +141,8 @@ namespace GDCC::AR::Wad
          std::shared_ptr<Core::FileBlock> const &file);
       virtual ~Lump_FilePart();
 
+      virtual char const *getData(std::unique_ptr<Core::FileBlock> &block) const;
+
       virtual std::size_t sizeData() const;
 
       virtual void writeData(std::ostream &out) const;
@@ -14,7 +14,14 @@
 
 #include "Core/BinaryIO.hpp"
 #include "Core/Dir.hpp"
+#include "Core/File.hpp"
+#include "Core/Parallel.hpp"
 #include "Core/Path.hpp"
+#include "Core/String.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <unordered_map>
 
 
 //----------------------------------------------------------------------------|
@@ -27,6 +34,7 @@ namespace GDCC::AR::Wad
    // Wad constructor
    //
    Wad::Wad() :
+      dedup{false},
       iwad{false}
    {
    }
@@ -77,36 +85,152 @@ namespace GDCC::AR::Wad
       return n;
    }
 
+   //
+   // Wad::hashData
+   //
+   // Hashes the contents of every lump ahead of writing, using up to jobs
+   // threads. Each lump keeps its hash, so later compares do not read it
+   // again.
+   //
+   void Wad::hashData(std::size_t jobs) const
+   {
+      std::vector<Lump const *> heads;
+      for(auto const &lump : *this)
+         lump.getHead(heads);
+
+      Core::ParallelFor(jobs, heads.size(),
+         [&](std::size_t i) {heads[i]->getHash();});
+   }
+
    //
    // Wad::writeData
    //
    void Wad::writeData(std::ostream &out) const
    {
+      if(dedup)
+         return writeDataDedup(out);
+
       // Count number of lumps.
       std::size_t numLumps = 0;
       for(auto const &lump : *this)
          numLumps += lump.sizeHead();
 
+      // Archive header and lump headers are built in memory and written at
+      // once, ahead of the lump data.
+      std::ostringstream dirs;
+
       // Write archive header.
       std::size_t offset = 16;
-      out.write(iwad ? "IWAD" : "PWAD", 4);
-      Core::WriteLE4(out, numLumps);
-      Core::WriteLE4(out, offset);
-      out.write("GDCC", 4);
+      dirs.write(iwad ? "IWAD" : "PWAD", 4);
+      Core::WriteLE4(dirs, numLumps);
+      Core::WriteLE4(dirs, offset);
+      dirs.write("GDCC", 4);
 
       // Write lump headers.
       offset += numLumps * 16;
       for(auto const &lump : *this)
       {
-         lump.writeHead(out, offset);
+         lump.writeHead(dirs, offset);
          offset += lump.sizeData();
       }
 
+      auto dirsStr = dirs.str();
+      out.write(dirsStr.data(), dirsStr.size());
+
       // Write lump data.
       for(auto const &lump : *this)
          lump.writeData(out);
    }
 
+   //
+   // Wad::writeDataDedup
+   //
+   // Directory entries for lumps with identical contents share an offset,
+   // with the data written only for the first.
+   //
+   void Wad::writeDataDedup(std::ostream &out) const
+   {
+      std::vector<Lump const *> heads;
+      for(auto const &lump : *this)
+         lump.getHead(heads);
+
+      std::size_t numLumps = heads.size();
+
+      std::vector<std::unique_ptr<Core::FileBlock>> blocks;
+      std::vector<char const *>                     datas(numLumps);
+      std::vector<std::size_t>                      sizes(numLumps);
+      std::vector<std::size_t>                      offsets(numLumps);
+      std::vector<bool>                             writes(numLumps);
+      std::unordered_multimap<std::size_t, std::size_t> uniqs;
+
+      // Assign offsets.
+      std::size_t offset = 16 + numLumps * 16;
+      for(std::size_t i = 0; i != numLumps; ++i)
+      {
+         std::unique_ptr<Core::FileBlock> block;
+
+         auto size = sizes[i] = heads[i]->sizeData();
+         auto data = datas[i] = size ? heads[i]->getData(block) : nullptr;
+
+         if(block)
+            blocks.push_back(std::move(block));
+
+         // Look for earlier lump with the same contents.
+         if(data)
+         {
+            auto hash  = heads[i]->getHash();
+            auto range = uniqs.equal_range(hash);
+            auto itr   = range.first;
+
+            for(; itr != range.second; ++itr)
+            {
+               auto j = itr->second;
+               if(sizes[j] == size && !std::memcmp(datas[j], data, size))
+                  break;
+            }
+
+            if(itr != range.second)
+            {
+               offsets[i] = offsets[itr->second];
+               continue;
+            }
+
+            uniqs.emplace(hash, i);
+         }
+
+         offsets[i] = offset;
+         writes[i]  = true;
+         offset    += size;
+      }
+
+      std::ostringstream dirs;
+
+      // Write archive header.
+      dirs.write(iwad ? "IWAD" : "PWAD", 4);
+      Core::WriteLE4(dirs, numLumps);
+      Core::WriteLE4(dirs, 16);
+      dirs.write("GDCC", 4);
+
+      // Write lump headers.
+      for(std::size_t i = 0; i != numLumps; ++i)
+         heads[i]->writeHead(dirs, offsets[i]);
+
+      auto dirsStr = dirs.str();
+      out.write(dirsStr.data(), dirsStr.size());
+
+      // Write lump data.
+      for(std::size_t i = 0; i != numLumps; ++i)
+      {
+         if(!writes[i])
+            continue;
+
+         if(datas[i])
+            out.write(datas[i], sizes[i]);
+         else
+            heads[i]->writeData(out);
+      }
+   }
+
    //
    // Wad::writeDirs
    //
@@ -145,11 +269,34 @@ namespace GDCC::AR::Wad
    {
    }
 
+   //
+   // Lump_Wad::getHead
+   //
+   void Lump_Wad::getHead(std::vector<Lump const *> &heads) const
+   {
+      if(embed)
+      {
+         if(head)
+            head->getHead(heads);
+
+         for(auto const &lump : wad)
+            lump.getHead(heads);
+
+         if(tail)
+            tail->getHead(heads);
+      }
+      else
+         Lump::getHead(heads);
+   }
+
    //
    // Lump_Wad::sizeData
    //
    std::size_t Lump_Wad::sizeData() const
    {
+      if(cacheData)
+         return cacheData;
+
       if(embed)
       {
          std::size_t n = 0;
@@ -163,10 +310,10 @@ namespace GDCC::AR::Wad
          if(tail)
             n += tail->sizeData();
 
-         return n;
+         return cacheData = n;
       }
       else
-         return wad.sizeData();
+         return cacheData = wad.sizeData();
    }
 
    //
@@ -174,10 +321,21 @@ namespace GDCC::AR::Wad
    //
    std::size_t Lump_Wad::sizeHead() const
    {
+      if(cacheHead)
+         return cacheHead;
+
       if(embed)
-         return wad.size() + !!head + !!tail;
+      {
+         // Embedded sub-wads contribute all of their own headers.
+         std::size_t n = !!head + !!tail;
+
+         for(auto const &lump : wad)
+            n += lump.sizeHead();
+
+         return cacheHead = n;
+      }
       else
-         return 1;
+         return cacheHead = 1;
    }
 
    //
@@ -58,16 +58,23 @@ namespace GDCC::AR::Wad
 
       std::size_t sizeData() const;
 
+      void hashData(std::size_t jobs) const;
+
       void writeData(std::ostream &out) const;
       void writeDirs(std::string &path) const;
       void writeList(std::ostream &out) const;
       void writeList(std::ostream &out, std::string &path) const;
 
+      bool writeUpdate(char const *filename) const;
+
+      bool dedup; // Write identical lump contents once.
       bool iwad;
 
    private:
       Lump_Wad &getSub(Core::String name);
 
+      void writeDataDedup(std::ostream &out) const;
+
       Lump_Empty head;
    };
 
@@ -81,6 +88,8 @@ namespace GDCC::AR::Wad
 
       void addLump(LumpInfo const &info, Core::Range<Core::String const *> path);
 
+      virtual void getHead(std::vector<Lump const *> &heads) const;
+
       virtual std::size_t sizeData() const;
       virtual std::size_t sizeHead() const;
 
@@ -93,6 +102,11 @@ namespace GDCC::AR::Wad
       std::unique_ptr<Lump> head;
       std::unique_ptr<Lump> tail;
       bool                  embed;
+
+   private:
+      // Sizes are computed once the wad is written.
+      mutable std::size_t cacheData = 0;
+      mutable std::size_t cacheHead = 0;
    };
 }
 
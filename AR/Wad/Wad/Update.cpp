@@ -0,0 +1,304 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2025 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Wad in-place updating.
+//
+//-----------------------------------------------------------------------------
+
+#include "AR/Wad/Wad.hpp"
+
+#include "AR/Wad/WadHeader.hpp"
+
+#include "Core/BinaryIO.hpp"
+#include "Core/File.hpp"
+#include "Core/String.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::AR::Wad
+{
+   //
+   // UpdateHoles
+   //
+   // Tracks unused space in an archive being updated.
+   //
+   class UpdateHoles
+   {
+   public:
+      //
+      // alloc
+      //
+      // Finds space for size bytes, preferring the first hole that fits.
+      //
+      std::size_t alloc(std::size_t size)
+      {
+         for(auto itr = holes.begin(), last = holes.end(); itr != last; ++itr)
+         {
+            if(itr->second < size)
+               continue;
+
+            auto offset = itr->first, left = itr->second - size;
+            holes.erase(itr);
+            if(left)
+               holes.emplace(offset + size, left);
+
+            return offset;
+         }
+
+         auto offset = end;
+         end += size;
+         return offset;
+      }
+
+      std::map<std::size_t, std::size_t> holes; // Offset to size.
+      std::size_t                        end;   // Start of trailing space.
+   };
+
+   //
+   // UpdateLump
+   //
+   class UpdateLump
+   {
+   public:
+      //
+      // getData
+      //
+      char const *getData()
+      {
+         if(data || !size)
+            return data;
+
+         if(!(data = lump->getData(block)))
+         {
+            // Lumps without contiguous contents are written out to compare.
+            std::ostringstream out;
+            lump->writeData(out);
+            buf  = out.str();
+            data = buf.data();
+         }
+
+         return data;
+      }
+
+      Lump const                      *lump;
+      std::unique_ptr<Core::FileBlock> block;
+      std::string                      buf;
+      char const                      *data;
+      std::size_t                      offset;
+      std::size_t                      size;
+      bool                             write;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::AR::Wad
+{
+   //
+   // Wad::writeUpdate
+   //
+   // Rewrites an existing archive in place. Lumps whose contents are already
+   // in the archive keep their data, and only changed lumps and the lump
+   // headers are written. New data only goes in space that the old headers
+   // do not refer to, and the archive header is written last, so the old
+   // archive stays readable until the update is complete.
+   //
+   // Returns false without writing anything if filename is not an archive.
+   //
+   bool Wad::writeUpdate(char const *filename) const
+   {
+      if(!Core::IsFile(filename))
+         return false;
+
+      auto oldBlock = Core::FileOpenBlock(filename);
+
+      if(oldBlock->size() < 16 || (std::memcmp(oldBlock->data(), "IWAD", 4) &&
+         std::memcmp(oldBlock->data(), "PWAD", 4)))
+         return false;
+
+      WadHeader old{oldBlock->data(), oldBlock->size()};
+
+      std::size_t              oldNum = old.lumps.size();
+      std::vector<std::size_t> oldHash(oldNum);
+      std::vector<bool>        oldHashed(oldNum);
+      std::vector<bool>        oldUsed(oldNum);
+
+      std::unordered_multimap<std::size_t, std::size_t> oldBySize;
+
+      for(std::size_t j = 0; j != oldNum; ++j)
+         if(old.lumps[j].size) oldBySize.emplace(old.lumps[j].size, j);
+
+      auto getOldHash = [&](std::size_t j)
+      {
+         if(!oldHashed[j])
+         {
+            oldHash[j]   = Core::StrHash(old.lumps[j].data, old.lumps[j].size);
+            oldHashed[j] = true;
+         }
+
+         return oldHash[j];
+      };
+
+      auto getOldOffset = [&](std::size_t j) -> std::size_t
+         {return old.lumps[j].data - oldBlock->data();};
+
+      std::vector<Lump const *> heads;
+      for(auto const &lump : *this)
+         lump.getHead(heads);
+
+      std::size_t             numLumps = heads.size();
+      std::vector<UpdateLump> lumps(numLumps);
+
+      // Find lumps already in the archive.
+      for(std::size_t i = 0; i != numLumps; ++i)
+      {
+         auto &lump = lumps[i];
+
+         lump.lump   = heads[i];
+         lump.data   = nullptr;
+         lump.offset = 0;
+         lump.size   = heads[i]->sizeData();
+         lump.write  = false;
+
+         if(!lump.size)
+            continue;
+
+         // Look for the same contents anywhere in the archive.
+         auto range = oldBySize.equal_range(lump.size);
+         auto itr   = range.first;
+
+         for(; itr != range.second; ++itr)
+         {
+            auto j = itr->second;
+            if((!oldUsed[j] || dedup) && getOldHash(j) == lump.lump->getHash() &&
+               !std::memcmp(old.lumps[j].data, lump.getData(), lump.size))
+               break;
+         }
+
+         if(itr != range.second)
+         {
+            lump.offset          = getOldOffset(itr->second);
+            oldUsed[itr->second] = true;
+            continue;
+         }
+
+         lump.write = true;
+      }
+
+      // Collect space not referred to by the old headers. Kept lumps are all
+      // within old lumps, so this also leaves their data in place.
+      std::vector<std::pair<std::size_t, std::size_t>> used;
+      for(std::size_t j = 0; j != oldNum; ++j)
+         if(old.lumps[j].size) used.emplace_back(getOldOffset(j), old.lumps[j].size);
+
+      if(oldNum)
+         used.emplace_back(Core::ReadLE4(oldBlock->data() + 8), oldNum * 16);
+
+      std::sort(used.begin(), used.end());
+
+      UpdateHoles holes;
+      holes.end = 16;
+      for(auto const &u : used)
+      {
+         if(u.first > holes.end)
+            holes.holes.emplace(holes.end, u.first - holes.end);
+
+         holes.end = std::max(holes.end, u.first + u.second);
+      }
+
+      // Place changed lumps.
+      std::unordered_multimap<std::size_t, std::size_t> uniqs;
+      for(std::size_t i = 0; i != numLumps; ++i)
+      {
+         auto &lump = lumps[i];
+
+         if(!lump.write)
+            continue;
+
+         if(dedup)
+         {
+            auto range = uniqs.equal_range(lump.lump->getHash());
+            auto itr   = range.first;
+
+            for(; itr != range.second; ++itr)
+            {
+               auto &prev = lumps[itr->second];
+               if(prev.size == lump.size &&
+                  !std::memcmp(prev.getData(), lump.getData(), lump.size))
+                  break;
+            }
+
+            if(itr != range.second)
+            {
+               lump.offset = lumps[itr->second].offset;
+               lump.write  = false;
+               continue;
+            }
+
+            uniqs.emplace(lump.lump->getHash(), i);
+         }
+
+         lump.offset = holes.alloc(lump.size);
+      }
+
+      std::size_t dirsOffset = holes.alloc(numLumps * 16);
+
+      // Release the old contents before writing over them.
+      oldBlock.reset();
+
+      auto buf = Core::FileOpenStream(filename,
+         std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+      std::ostream out{buf.get()};
+
+      // Write changed lump data.
+      for(auto &lump : lumps)
+      {
+         if(!lump.write)
+            continue;
+
+         out.seekp(lump.offset);
+         if(auto data = lump.getData())
+            out.write(data, lump.size);
+      }
+
+      // Write lump headers.
+      std::ostringstream dirs;
+      for(std::size_t i = 0; i != numLumps; ++i)
+         heads[i]->writeHead(dirs, lumps[i].offset);
+
+      auto dirsStr = dirs.str();
+      out.seekp(dirsOffset);
+      out.write(dirsStr.data(), dirsStr.size());
+
+      // Write archive header, only after everything it refers to.
+      out.flush();
+      out.seekp(0);
+      out.write(iwad ? "IWAD" : "PWAD", 4);
+      Core::WriteLE4(out, numLumps);
+      Core::WriteLE4(out, dirsOffset);
+      out.write("GDCC", 4);
+
+      return true;
+   }
+}
+
+// EOF
+
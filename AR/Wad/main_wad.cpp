@@ -26,6 +26,21 @@
 // Options                                                                    |
 //
 
+//
+// --dedup
+//
+static GDCC::Option::Bool Dedup
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("dedup")
+      .setGroup("output")
+      .setDescS("Writes identical lump contents only once.")
+      .setDescL("Writes identical lump contents only once. Lumps with the "
+         "same contents share a single copy of the data in the archive."),
+
+   false
+};
+
 //
 // --extract
 //
@@ -63,6 +78,23 @@ static GDCC::Option::CStr OptionList
       .setDescS("Outputs list of lumps to a file."),
 };
 
+//
+// --update
+//
+static GDCC::Option::Bool Update
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("update")
+      .setGroup("output")
+      .setDescS("Updates an existing archive in place.")
+      .setDescL("Updates an existing archive in place. Lumps whose contents "
+         "are already in the archive are kept, and only changed lumps and "
+         "the lump headers are written. If the output is not an existing "
+         "archive, it is written normally."),
+
+   false
+};
+
 
 //----------------------------------------------------------------------------|
 // Static Functions                                                           |
@@ -76,12 +108,17 @@ static void ProcessFile(char const *data, GDCC::AR::Wad::Wad &wad);
 static void MakeWad()
 {
    GDCC::AR::Wad::Wad wad;
-   wad.iwad = IWad;
+   wad.dedup = Dedup;
+   wad.iwad  = IWad;
 
    // Process inputs.
    for(auto const &arg : GDCC::Core::GetOptionArgs())
       ProcessFile(arg, wad);
 
+   // Hash lump contents ahead of comparing them.
+   if((Dedup || Update) && !Extract)
+      wad.hashData(GDCC::Core::GetOptions().optJobs);
+
    // Write lump list.
    if(auto listFile = OptionList.data())
    {
@@ -98,7 +135,7 @@ static void MakeWad()
          std::string path{outFile};
          wad.writeDirs(path);
       }
-      else
+      else if(!Update || !wad.writeUpdate(outFile))
       {
          auto buf = GDCC::Core::FileOpenStream(outFile,
             std::ios_base::out | std::ios_base::binary);
@@ -157,7 +194,12 @@ int main(int argc, char *argv[])
       "added directly to the root wad. Otherwise, they are added to a sub-wad.\n"
       "wad (directory) - Adds a set of lumps from a directory. "
       "Sub-directories are added as *_START or map sub-wads if applicable. "
-      "LUMP usage is the same as for a file.";
+      "LUMP usage is the same as for a file.\n"
+      "\n"
+      "--jobs sets how many lumps are hashed at once for --dedup and "
+      "--update. Otherwise, sources are read one at a time while writing.";
+
+   opts.optJobs.insert(&opts.list);
 
    try
    {
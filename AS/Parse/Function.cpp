@@ -45,6 +45,8 @@ namespace GDCC::AS
       case Core::STR_ctype:    func.ctype    = GetCallType(TokenDropEq(ctx));   break;
       case Core::STR_defin:    func.defin    = GetFastU(TokenDropEq(ctx));      break;
       case Core::STR_label:    func.label    = GetString(TokenDropEq(ctx));     break;
+      case Core::STR_inlineAlways: func.inlineAlways = GetFastU(TokenDropEq(ctx)); break;
+      case Core::STR_inlineNever:  func.inlineNever  = GetFastU(TokenDropEq(ctx)); break;
       case Core::STR_linka:    func.linka    = GetLinkage(TokenDropEq(ctx));    break;
       case Core::STR_localAut: func.localAut = GetFastU(TokenDropEq(ctx));      break;
       case Core::STR_localReg: func.localReg = GetFastU(TokenDropEq(ctx));      break;
@@ -67,6 +67,9 @@ namespace GDCC::BC::DGE
 
       bool isDropArg(IR::Arg const &arg);
 
+      virtual std::unique_ptr<InfoBase> newInfo() const
+         {return std::unique_ptr<InfoBase>{new Info};}
+
       virtual void preStmnt();
 
       void preStmnt_Add();
@@ -66,7 +66,7 @@ namespace GDCC::BC::DGE
       if(func->allocAut)
       {
          putCode("Push_Reg", getStkPtrIdx());
-         putCode("Push_Lit", "___GDCC__Plsf");
+         putCode("Push_Lit", FuncFreeAut);
          putCode("Call",     1);
       }
 
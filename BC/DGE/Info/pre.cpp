@@ -39,10 +39,10 @@ namespace GDCC::BC::DGE
       case IR::CodeBase::CmpLE: preStmnt_CmpLE(); break;
       case IR::CodeBase::CmpLT: preStmnt_CmpLT(); break;
       case IR::CodeBase::CmpNE: preStmnt_CmpNE(); break;
-      case IR::CodeBase::Div:   preStmnt_Div(); break;
+      case IR::CodeBase::Div:   preStmnt_Div_Lit(); preStmnt_Div(); break;
       case IR::CodeBase::DivX:  preStmnt_DivX(); break;
-      case IR::CodeBase::Mod:   preStmnt_Mod(); break;
-      case IR::CodeBase::Mul:   preStmnt_Mul(); break;
+      case IR::CodeBase::Mod:   preStmnt_Mod_Lit(); preStmnt_Mod(); break;
+      case IR::CodeBase::Mul:   preStmnt_Mul_Lit(); preStmnt_Mul(); break;
       case IR::CodeBase::MulX:  preStmnt_MulX(); break;
       case IR::CodeBase::Neg:   preStmnt_Neg(); break;
       case IR::CodeBase::ShL:   preStmnt_ShL(); break;
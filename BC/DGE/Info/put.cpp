@@ -300,7 +300,7 @@ namespace GDCC::BC::DGE
                putOrigin(func->block.begin()->pos);
 
             putCode("Push_Lit", func->allocAut);
-            putCode("Push_Lit", "___GDCC__Plsa");
+            putCode("Push_Lit", FuncAllocAut);
             putCode("Call",     1);
             putCode("Drop_Reg", getStkPtrIdx());
          }
@@ -335,7 +335,7 @@ namespace GDCC::BC::DGE
       len = std::sprintf(buf, "%jX", static_cast<std::uintmax_t>(i));
 
       if(!std::isdigit(buf[0]))
-         out->put('0'), ++putPos;
+         putData("0", 1);
 
       putData(buf, len + 1);
    }
@@ -345,9 +345,10 @@ namespace GDCC::BC::DGE
    //
    void Info::putNTS(char nts)
    {
-      out->put(nts);
-      out->put('\0');
-      putPos += 2;
+      char *data = putAlloc(2);
+
+      data[0] = nts;
+      data[1] = '\0';
    }
 
    //
@@ -12,11 +12,18 @@
 
 #include "BC/Info.hpp"
 
+#include "Core/Option.hpp"
+#include "Core/Parallel.hpp"
+
 #include "IR/Exception.hpp"
 #include "IR/Program.hpp"
 
+#include "Option/Int.hpp"
+
 #include "Target/Info.hpp"
 
+#include <vector>
+
 
 //----------------------------------------------------------------------------|
 // Macros                                                                     |
@@ -41,7 +48,7 @@
 //
 // DefaultFunc_Base
 //
-#define DefaultFunc_Base(set) \
+#define DefaultFunc_Base(set, type) \
    void Info::set() \
    { \
       for(auto &itr : prog->rangeDJump())  set##DJump(itr); \
@@ -58,14 +65,38 @@
       set##Space(prog->getSpaceModReg()); \
       set##Space(prog->getSpaceSta()); \
       \
-      for(;;) try \
-      { \
-         for(auto &itr : prog->rangeFunction()) set##Func(itr); \
-         break; \
-      } \
-      catch(ResetFunc const &) {} \
+      DefaultFunc_Base_##type(set) \
    }
 
+//
+// DefaultFunc_Base_Func
+//
+#define DefaultFunc_Base_Func(set) \
+   for(;;) try \
+   { \
+      for(auto &itr : prog->rangeFunction()) set##Func(itr); \
+      break; \
+   } \
+   catch(ResetFunc const &) {}
+
+//
+// DefaultFunc_Base_Jobs
+//
+// Passes that only modify the current function may run on several at once.
+//
+#define DefaultFunc_Base_Jobs(set) \
+   forFunc(&Info::set##Func);
+
+//
+// DefaultFunc_Base_Inline
+//
+// Inlining copies between functions, so it runs before any of them are
+// handled on their own.
+//
+#define DefaultFunc_Base_Inline(set) \
+   set##Inline(); \
+   DefaultFunc_Base_Jobs(set)
+
 //
 // DefaultFunc_Block
 //
@@ -132,26 +163,54 @@
    DeferFunc(StrEnt,    set##StrEnt,   strent) \
 
 
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --bc-jobs
+   //
+   static Option::Int<std::size_t> Jobs
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-jobs")
+         .setGroup("codegen")
+         .setDescS("Sets the number of functions to process at once.")
+         .setDescL("Sets the number of functions to process at once. Only "
+            "the chk, opt, and tr passes are run this way, and each function "
+            "is handled independently, so output does not depend on this "
+            "option. If 0, uses one job per hardware thread.\n"
+            "\n"
+            "Default is 1."),
+
+      1
+   };
+}
+
+
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
 //
 
 namespace GDCC::BC
 {
-   DefaultFunc_Base(chk)
-   DefaultFunc_Base(gen)
-   DefaultFunc_Base(opt)
-   DefaultFunc_Base(pre)
-   DefaultFunc_Base(tr)
+   DefaultFunc_Base(chk, Jobs)
+   DefaultFunc_Base(gen, Func)
+   DefaultFunc_Base(opt, Inline)
+   DefaultFunc_Base(pre, Func)
+   DefaultFunc_Base(tr,  Jobs)
 
    DefaultFuncSet(chk)
    DefaultFuncSet(gen)
-   DefaultFuncSet(opt)
+   DefaultFunc_Block(opt)
    DefaultFuncSet(pre)
    DefaultFuncSet(put)
    DefaultFuncSet(tr)
 
    DeferFunc(Program, chk, prog)
+   DeferFunc(Program, gc,  prog)
    DeferFunc(Program, gen, prog)
    DeferFunc(Program, opt, prog)
    DeferFunc(Program, pre, prog)
@@ -169,23 +228,36 @@ namespace GDCC::BC
    //
    // Info::put
    //
-   void Info::put(IR::Program &prog_, std::ostream &out_)
+   // Returns the output as a single buffer of size bytes.
+   //
+   std::unique_ptr<char[]> Info::put(IR::Program &prog_, std::size_t &size)
    {
       try
       {
-         out  = &out_;
          prog = &prog_;
 
-         putPos = 0;
+         putPos       = 0;
+         wordCacheUse = true;
          put();
 
-         out  = nullptr;
          prog = nullptr;
+
+         wordCache.clear();
+         wordCacheUse = false;
+
+         size       = putPos;
+         putBufSize = 0;
+         return std::move(putBuf);
       }
       catch(...)
       {
-         out  = nullptr;
          prog = nullptr;
+
+         wordCache.clear();
+         wordCacheUse = false;
+
+         putBuf.reset();
+         putBufSize = 0;
          throw;
       }
    }
@@ -199,6 +271,39 @@ namespace GDCC::BC
       IR::ErrorCode(stmnt, msg);
    }
 
+   //
+   // Info::forFunc
+   //
+   // Calls fn for every function. With more than one job, each function gets
+   // its own context from newInfo, so fn must not modify anything shared.
+   //
+   void Info::forFunc(void (Info::*fn)(IR::Function &))
+   {
+      std::unique_ptr<Info> info;
+
+      if(Jobs != 1)
+         info = newInfo();
+
+      if(!info)
+      {
+         for(auto &itr : prog->rangeFunction())
+            (this->*fn)(itr);
+
+         return;
+      }
+
+      std::vector<IR::Function *> funcs;
+      for(auto &itr : prog->rangeFunction())
+         funcs.push_back(&itr);
+
+      Core::ParallelFor(Jobs, funcs.size(), [&](std::size_t i)
+      {
+         auto ctx = newInfo();
+         ctx->prog = prog;
+         (ctx.get()->*fn)(*funcs[i]);
+      });
+   }
+
    //
    // Info::getExpAddPtr
    //
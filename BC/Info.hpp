@@ -15,10 +15,15 @@
 
 #include "../BC/Types.hpp"
 
+#include "../Core/Array.hpp"
 #include "../Core/Counter.hpp"
 #include "../Core/Number.hpp"
 
-#include <ostream>
+#include "../IR/Exp.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 
 //----------------------------------------------------------------------------|
@@ -154,12 +159,13 @@ namespace GDCC::BC
          block{nullptr},
          func{nullptr},
          obj{nullptr},
-         out{nullptr},
          prog{nullptr},
          space{nullptr},
          stmnt{nullptr},
          strent{nullptr},
-         putPos{0}
+         putBufSize{0},
+         putPos{0},
+         wordCacheUse{false}
       {
       }
 
@@ -167,13 +173,15 @@ namespace GDCC::BC
 
       void chk(IR::Program &prog);
 
+      void gc(IR::Program &prog);
+
       void gen(IR::Program &prog);
 
       void opt(IR::Program &prog);
 
       void pre(IR::Program &prog);
 
-      void put(IR::Program &prog, std::ostream &out);
+      std::unique_ptr<char[]> put(IR::Program &prog, std::size_t &size);
 
       void putExtra(IR::Program &prog);
 
@@ -195,6 +203,19 @@ namespace GDCC::BC
 
       using WordArray = Core::Array<WordValue>;
 
+      // Flattened words of an expression's value.
+      class WordCache
+      {
+      public:
+         IRExpCPtr                exp;
+         Core::Array<Core::FastU> words;
+      };
+
+      // Runtime functions that allocate and free a function's automatic
+      // storage. Calls are added during code generation.
+      static constexpr char const *FuncAllocAut = "___GDCC__Plsa";
+      static constexpr char const *FuncFreeAut  = "___GDCC__Plsf";
+
 
       virtual void chk();
       virtual void chkBlock();
@@ -212,6 +233,10 @@ namespace GDCC::BC
       virtual void chkStrEnt() {}
               void chkStrEnt(IR::StrEnt &strent);
 
+      virtual void gc();
+      // Appends glyphs referred to by func other than by its statements.
+      virtual void gcFunc(std::vector<Core::String> &refs);
+
       virtual void gen();
       virtual void genBlock();
               void genBlock(IR::Block &block);
@@ -235,7 +260,7 @@ namespace GDCC::BC
               void optDJump(IR::DJump &djump);
       virtual void optFunc();
               void optFunc(IR::Function &func);
-      virtual void optObj() {}
+      virtual void optObj();
               void optObj(IR::Object &obj);
       virtual void optSpace() {}
               void optSpace(IR::Space &space);
@@ -294,6 +319,10 @@ namespace GDCC::BC
       virtual void trStrEnt() {}
               void trStrEnt(IR::StrEnt &strent);
 
+      // Returns a new context for processing a single function, or null if
+      // functions must be processed in sequence.
+      virtual std::unique_ptr<Info> newInfo() const {return nullptr;}
+
       void addFunc(Core::String name, Core::FastU retrn, Core::FastU param);
 
       void addFunc_Add_FW(Core::FastU n);
@@ -355,6 +384,8 @@ namespace GDCC::BC
       [[noreturn]]
       void errorCode(char const *msg);
 
+      void forFunc(void (Info::*fn)(IR::Function &));
+
       Core::CounterRef<IR::Exp const> getExpAddPtr(IR::Exp const *l, Core::FastU r);
       Core::CounterRef<IR::Exp const> getExpGlyph(Core::String glyph);
 
@@ -406,15 +437,29 @@ namespace GDCC::BC
       WordArray getWords_Tuple(IR::Exp_Tuple const *exp);
       WordArray getWords_Union(IR::Exp_Union const *exp);
 
+      char *putAlloc(std::size_t size);
+
       void putData(char const *data, std::size_t size);
 
+      void putReserve(std::size_t size);
+
       void moveArgStk_dst(IR::Arg &idx);
       void moveArgStk_src(IR::Arg &idx, bool swap = false);
 
+      void optFunc_LocReg();
+      void optFunc_Prop();
+      void optFunc_Tail();
+
+      void optInline();
+
       bool optStmnt_Cspe_Drop();
       bool optStmnt_JumpNext();
       bool optStmnt_LNot_Jcnd();
 
+      void preStmnt_Div_Lit();
+      void preStmnt_Mod_Lit();
+      void preStmnt_Mul_Lit();
+
       void trStmntStk2();
       void trStmntStk3(bool ordered);
       bool trStmntShift(bool moveLit);
@@ -423,12 +468,18 @@ namespace GDCC::BC
       IR::DJump     *djump;
       IR::Function  *func;
       IR::Object    *obj;
-      std::ostream  *out;
       IR::Program   *prog;
       IR::Space     *space;
       IR::Statement *stmnt;
       IR::StrEnt    *strent;
-      std::size_t    putPos;
+
+      std::unique_ptr<char[]> putBuf;
+      std::size_t             putBufSize;
+      std::size_t             putPos;
+
+      // Only used during put, when all glyphs have their final values.
+      std::unordered_map<IR::Exp const *, WordCache> wordCache;
+      bool                                           wordCacheUse;
 
    private:
       void addFunc_Add_UW(Core::FastU n, IR::Code codeAdd, IR::Code codeAdX);
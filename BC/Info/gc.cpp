@@ -0,0 +1,355 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2025 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Unreferenced glyph elimination.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Info.hpp"
+
+#include "Core/Option.hpp"
+
+#include "IR/Exp/Binary.hpp"
+#include "IR/Exp/Branch.hpp"
+#include "IR/Exp/Glyph.hpp"
+#include "IR/Exp/Multi.hpp"
+#include "IR/Exp/Unary.hpp"
+#include "IR/Linkage.hpp"
+#include "IR/Program.hpp"
+
+#include "Option/Bool.hpp"
+#include "Option/CStrV.hpp"
+
+#include "Target/CallType.hpp"
+
+#include <unordered_set>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --gc-keep
+   //
+   static Option::CStrV GCKeep
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("gc-keep")
+         .setGroup("output")
+         .setDescS("Adds a glyph to keep when removing unused glyphs.")
+         .setDescL("Adds a glyph to keep when removing unused glyphs, along "
+            "with everything it refers to. Needed for functions and objects "
+            "only referred to by name from outside the output, such as C "
+            "functions called by other modules."),
+
+      1
+   };
+
+   //
+   // --gc-sections
+   //
+   static Option::Bool GCSections
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("gc-sections")
+         .setGroup("output")
+         .setDescS("Removes unused functions and objects.")
+         .setDescL("Removes unused functions and objects. Starting from "
+            "scripts, symbols with non-C linkage, glyphs with fixed values, "
+            "and any named by --gc-keep, everything not referred to is "
+            "dropped before allocation.\n"
+            "\n"
+            "Default is off."),
+
+      false
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::BC
+{
+   //
+   // GCData
+   //
+   class GCData
+   {
+   public:
+      void mark(Core::String glyph)
+         {if(live.insert(glyph).second) work.push_back(glyph);}
+
+      std::unordered_set<Core::String> live;
+      std::vector<Core::String>        work;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // GCMarkExp
+   //
+   static void GCMarkExp(GCData &gc, IR::Exp const *exp)
+   {
+      if(auto eGlyph = dynamic_cast<IR::Exp_Glyph const *>(exp))
+         gc.mark(eGlyph->glyph);
+
+      else if(auto eBin = dynamic_cast<IR::Exp_Binary const *>(exp))
+         GCMarkExp(gc, eBin->expL), GCMarkExp(gc, eBin->expR);
+
+      else if(auto eTer = dynamic_cast<IR::Exp_BraTer const *>(exp))
+         GCMarkExp(gc, eTer->expC), GCMarkExp(gc, eTer->expL), GCMarkExp(gc, eTer->expR);
+
+      else if(auto eBraB = dynamic_cast<IR::Exp_BraBin const *>(exp))
+         GCMarkExp(gc, eBraB->expL), GCMarkExp(gc, eBraB->expR);
+
+      else if(auto eBraU = dynamic_cast<IR::Exp_BraUna const *>(exp))
+         GCMarkExp(gc, eBraU->exp);
+
+      else if(auto eUna = dynamic_cast<IR::Exp_Unary const *>(exp))
+         GCMarkExp(gc, eUna->exp);
+
+      else if(auto eArr = dynamic_cast<IR::Exp_Array const *>(exp))
+         for(auto const &v : eArr->elemV) GCMarkExp(gc, v);
+
+      else if(auto eAsc = dynamic_cast<IR::Exp_Assoc const *>(exp))
+         for(auto const &v : eAsc->elemV) GCMarkExp(gc, v);
+
+      else if(auto eTup = dynamic_cast<IR::Exp_Tuple const *>(exp))
+         for(auto const &v : eTup->elemV) GCMarkExp(gc, v);
+
+      else if(auto eUni = dynamic_cast<IR::Exp_Union const *>(exp))
+         GCMarkExp(gc, eUni->elemV);
+   }
+
+   //
+   // GCMarkArg
+   //
+   static void GCMarkArg(GCData &gc, IR::Arg const &arg)
+   {
+      switch(arg.a)
+      {
+      case IR::ArgBase::Cpy:
+      case IR::ArgBase::Nul:
+      case IR::ArgBase::Stk:
+         break;
+
+      case IR::ArgBase::Lit:
+         GCMarkExp(gc, arg.aLit.value);
+         break;
+
+      #define GDCC_BC_ArgPtr1(name) case IR::ArgBase::name: \
+         GCMarkArg(gc, *arg.a##name.idx); break;
+      #define GDCC_BC_ArgPtr2(name) case IR::ArgBase::name: \
+         GCMarkArg(gc, *arg.a##name.arr); GCMarkArg(gc, *arg.a##name.idx); break;
+      GDCC_BC_ArgPtr1(Aut)
+      GDCC_BC_ArgPtr1(Far)
+      GDCC_BC_ArgPtr1(Gen)
+      GDCC_BC_ArgPtr1(GblArs)
+      GDCC_BC_ArgPtr1(GblReg)
+      GDCC_BC_ArgPtr1(HubArs)
+      GDCC_BC_ArgPtr1(HubReg)
+      GDCC_BC_ArgPtr1(LocReg)
+      GDCC_BC_ArgPtr1(ModArs)
+      GDCC_BC_ArgPtr1(ModReg)
+      GDCC_BC_ArgPtr1(Sta)
+      GDCC_BC_ArgPtr1(StrArs)
+      GDCC_BC_ArgPtr1(Vaa)
+      GDCC_BC_ArgPtr2(GblArr)
+      GDCC_BC_ArgPtr2(HubArr)
+      GDCC_BC_ArgPtr2(LocArr)
+      GDCC_BC_ArgPtr2(ModArr)
+      GDCC_BC_ArgPtr2(StrArr)
+      #undef GDCC_BC_ArgPtr2
+      #undef GDCC_BC_ArgPtr1
+      }
+   }
+
+   //
+   // IsGCRoot
+   //
+   // Returns true for linkage that can be referred to from outside C.
+   //
+   static bool IsGCRoot(IR::Linkage linka)
+   {
+      switch(linka)
+      {
+      case IR::Linkage::ExtACS:
+      case IR::Linkage::ExtASM:
+      case IR::Linkage::ExtAXX:
+      case IR::Linkage::ExtDS:
+         return true;
+
+      default:
+         return false;
+      }
+   }
+
+   //
+   // IsGCRoot
+   //
+   static bool IsGCRoot(IR::Function const &fn)
+   {
+      switch(fn.ctype)
+      {
+      case IR::CallType::SScript:
+      case IR::CallType::SScriptI:
+      case IR::CallType::SScriptS:
+      case IR::CallType::Script:
+      case IR::CallType::ScriptI:
+      case IR::CallType::ScriptS:
+         return true;
+
+      default:
+         return !fn.alloc || IsGCRoot(fn.linka);
+      }
+   }
+
+   //
+   // IsGCRoot
+   //
+   static bool IsGCRoot(IR::Space const &sp)
+   {
+      return !sp.alloc || IsGCRoot(sp.linka);
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // Info::gc
+   //
+   // Removes functions, objects, arrays, strings, and dynamic jumps that
+   // cannot be reached from any root. Must run before pre, since helper
+   // functions added there are only referred to by statement codes.
+   //
+   void Info::gc()
+   {
+      if(!GCSections)
+         return;
+
+      GCData gc;
+
+      // Labels are marked through the function that defines them.
+      std::unordered_map<Core::String, Core::String> labelFunc;
+
+      for(auto &fn : prog->rangeFunction())
+      {
+         labelFunc.emplace(fn.label, fn.glyph);
+         for(auto &st : fn.block)
+            for(auto const &lab : st.labs)
+               labelFunc.emplace(lab, fn.glyph);
+
+         if(IsGCRoot(fn))
+            gc.mark(fn.glyph);
+      }
+
+      for(auto &objItr : prog->rangeObject())
+         if(!objItr.alloc || IsGCRoot(objItr.linka)) gc.mark(objItr.glyph);
+
+      for(auto &sp : prog->rangeSpaceGblArs()) if(IsGCRoot(sp)) gc.mark(sp.glyph);
+      for(auto &sp : prog->rangeSpaceHubArs()) if(IsGCRoot(sp)) gc.mark(sp.glyph);
+      for(auto &sp : prog->rangeSpaceModArs()) if(IsGCRoot(sp)) gc.mark(sp.glyph);
+
+      for(auto &str : prog->rangeStrEnt())
+         if(!str.alloc) gc.mark(str.glyph);
+
+      for(auto name : GCKeep)
+         gc.mark(name);
+
+      // Follow references.
+      std::vector<Core::String> refs;
+      while(!gc.work.empty())
+      {
+         auto glyph = gc.work.back();
+         gc.work.pop_back();
+
+         if(auto fn = prog->findFunction(glyph))
+         {
+            for(auto &st : fn->block)
+               for(auto const &arg : st.args)
+                  GCMarkArg(gc, arg);
+
+            func = fn;
+            gcFunc(refs);
+            func = nullptr;
+
+            for(auto const &ref : refs)
+               gc.mark(ref);
+            refs.clear();
+         }
+
+         if(auto objItr = prog->findObject(glyph))
+         {
+            if(objItr->initi)
+               GCMarkExp(gc, objItr->initi);
+
+            if(auto sp = prog->findSpace(objItr->space); sp && sp->glyph)
+               gc.mark(sp->glyph);
+         }
+
+         if(auto dj = prog->findDJump(glyph))
+            gc.mark(dj->label);
+
+         if(auto lab = labelFunc.find(glyph); lab != labelFunc.end())
+            gc.mark(lab->second);
+      }
+
+      // Remove everything left unmarked.
+      auto erase = [&](auto range, void (IR::Program::*fn)(Core::String))
+      {
+         std::vector<Core::String> dead;
+         for(auto &itr : range)
+            if(!gc.live.count(itr.glyph)) dead.push_back(itr.glyph);
+
+         for(auto const &glyph : dead)
+            (prog->*fn)(glyph);
+      };
+
+      erase(prog->rangeDJump(),       &IR::Program::eraseDJump);
+      erase(prog->rangeFunction(),    &IR::Program::eraseFunction);
+      erase(prog->rangeObject(),      &IR::Program::eraseObject);
+      erase(prog->rangeSpaceGblArs(), &IR::Program::eraseSpaceGblArr);
+      erase(prog->rangeSpaceHubArs(), &IR::Program::eraseSpaceHubArr);
+      erase(prog->rangeSpaceModArs(), &IR::Program::eraseSpaceModArr);
+      erase(prog->rangeStrEnt(),      &IR::Program::eraseStrEnt);
+   }
+
+   //
+   // Info::gcFunc
+   //
+   // Automatic storage is allocated and freed by calls to FuncAllocAut and
+   // FuncFreeAut, which are added during code generation.
+   //
+   void Info::gcFunc(std::vector<Core::String> &refs)
+   {
+      if(func->defin && func->allocAut)
+      {
+         refs.emplace_back(FuncAllocAut);
+         refs.emplace_back(FuncFreeAut);
+      }
+   }
+}
+
+// EOF
+
@@ -19,6 +19,8 @@
 
 #include "Target/Info.hpp"
 
+#include <climits>
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -39,6 +41,26 @@ namespace GDCC::BC
    //
    Core::FastU Info::getWord(IR::Exp const *exp, Core::FastU w)
    {
+      if(!wordCacheUse)
+         return getWord(exp->pos, exp->getValue(), w);
+
+      // Evaluate each expression once, rather than once per word.
+      auto itr = wordCache.find(exp);
+      if(itr == wordCache.end())
+      {
+         auto        val  = exp->getValue();
+         Core::FastU size = getWordCount(val.getType());
+
+         Core::Array<Core::FastU> words{Core::Size, size};
+         for(Core::FastU i = 0; i != size; ++i)
+            words[i] = getWord(exp->pos, val, i);
+
+         itr = wordCache.emplace(exp, WordCache{exp, std::move(words)}).first;
+      }
+
+      if(w < itr->second.words.size())
+         return itr->second.words[w];
+
       return getWord(exp->pos, exp->getValue(), w);
    }
 
@@ -107,6 +129,17 @@ namespace GDCC::BC
    //
    Core::FastU Info::getWord_Fixed(IR::Value_Fixed const &val, Core::FastU w)
    {
+      // Values that fit in a long can be split without copying.
+      if(mpz_fits_slong_p(val.value.get_mpz_t()))
+      {
+         long valL = val.value.get_si();
+
+         if(w * 32 >= sizeof(long) * CHAR_BIT)
+            return valL < 0 ? 0xFFFFFFFF : 0;
+
+         return static_cast<Core::FastU>(valL >> (w * 32)) & 0xFFFFFFFF;
+      }
+
       auto valI = val.value;
 
       valI >>= w * 32;
@@ -0,0 +1,1718 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2025 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Generic function optimizations.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Info.hpp"
+
+#include "Core/Option.hpp"
+#include "Core/StringGen.hpp"
+
+#include "IR/Block.hpp"
+#include "IR/Exp/Glyph.hpp"
+#include "IR/Flow.hpp"
+#include "IR/Function.hpp"
+#include "IR/Object.hpp"
+#include "IR/Program.hpp"
+
+#include "Option/Bool.hpp"
+#include "Option/Int.hpp"
+
+#include "Target/CallType.hpp"
+#include "Target/Info.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --bc-opt-prop
+   //
+   static Option::Bool OptProp
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-opt-prop")
+         .setGroup("codegen")
+         .setDescS("Enables or disables constant and copy propagation.")
+         .setDescL(
+            "Enables or disables constant and copy propagation. When "
+            "enabled, reads of local registers that can only hold a literal "
+            "or a copy of another register are replaced by that value, "
+            "operations on literals are folded, and stores to registers "
+            "that are never read are removed.\n"
+            "\n"
+            "Default is on."),
+
+      true
+   };
+
+   //
+   // --bc-opt-inline
+   //
+   static Option::Bool OptInline
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-opt-inline")
+         .setGroup("codegen")
+         .setDescS("Enables or disables inlining of small functions.")
+         .setDescL(
+            "Enables or disables inlining of small functions. When enabled, "
+            "calls to functions that make no calls of their own and are no "
+            "larger than --bc-opt-inline-size are replaced by a copy of the "
+            "function's body, using the caller's local registers. Functions "
+            "declared [[inline]] are inlined regardless of size, and those "
+            "declared [[noinline]] are never inlined.\n"
+            "\n"
+            "Default is on."),
+
+      true
+   };
+
+   //
+   // --bc-opt-inline-size
+   //
+   static Option::Int<std::size_t> OptInlineSize
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-opt-inline-size")
+         .setGroup("codegen")
+         .setDescS("Sets the largest function to inline, in statements.")
+         .setDescL(
+            "Sets the largest function to inline, in statements. Counts IR "
+            "statements, including the return.\n"
+            "\n"
+            "Default is 8."),
+
+      8
+   };
+
+   //
+   // --bc-opt-tail-call
+   //
+   static Option::Bool OptTailCall
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-opt-tail-call")
+         .setGroup("codegen")
+         .setDescS("Enables or disables self tail call elimination.")
+         .setDescL(
+            "Enables or disables self tail call elimination. When enabled, "
+            "a function's calls to itself whose result is immediately "
+            "returned are replaced by storing the arguments to its "
+            "parameters and jumping back to its start. Only done for "
+            "functions without automatic storage.\n"
+            "\n"
+            "Default is on."),
+
+      true
+   };
+
+   //
+   // --bc-opt-local-reg
+   //
+   static Option::Bool OptLocalReg
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-opt-local-reg")
+         .setGroup("codegen")
+         .setDescS("Enables or disables local register packing.")
+         .setDescL(
+            "Enables or disables local register packing. When enabled, local "
+            "registers whose values are never live at the same time share "
+            "the same register, reducing the number of registers needed by "
+            "each function.\n"
+            "\n"
+            "Default is on."),
+
+      true
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::BC
+{
+   //
+   // InlineMap
+   //
+   // Renaming of a function's registers and labels at a call site.
+   //
+   struct InlineMap
+   {
+      IR::Program                                   *prog;
+      Core::FastU                                    base;
+      std::unordered_map<Core::String, Core::String> labs;
+   };
+
+   //
+   // LocRegUse
+   //
+   // A local register access, in words.
+   //
+   struct LocRegUse
+   {
+      IR::Arg        *outer;
+      IR::Arg_LocReg *arg;
+      Core::FastU     addr;
+      Core::FastU     lo, hi;
+      std::size_t     stmnt;
+      std::size_t     slot;
+      bool            dst; // Written.
+      bool            mod; // Read and written.
+   };
+
+   //
+   // LocRegSlot
+   //
+   // A range of words that is always accessed as a whole.
+   //
+   struct LocRegSlot
+   {
+      Core::FastU lo, hi;
+      Core::FastU loNew;
+      bool        pin;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // FindLocRegSlot
+   //
+   static std::size_t FindLocRegSlot(std::vector<LocRegSlot> const &slots,
+      Core::FastU lo)
+   {
+      return std::upper_bound(slots.begin(), slots.end(), lo,
+         [](Core::FastU l, LocRegSlot const &slot) {return l < slot.lo;})
+         - slots.begin() - 1;
+   }
+
+   //
+   // GetLocRegAddr
+   //
+   // Returns false if the register's address is not a known value.
+   //
+   static bool GetLocRegAddr(IR::Arg_LocReg const &a, Core::FastU &addr)
+   {
+      if(a.idx->a != IR::ArgBase::Lit || a.idx->aLit.off ||
+         !a.idx->aLit.value->isValue())
+         return false;
+
+      auto val = a.idx->aLit.value->getValue();
+      if(val.v == IR::ValueBase::Fixed)
+         addr = a.off + Core::NumberCast<Core::FastU>(val.vFixed.value);
+      else if(val.v == IR::ValueBase::Point)
+         addr = a.off + val.vPoint.value;
+      else
+         return false;
+
+      return true;
+   }
+
+   //
+   // IsLocRegDst
+   //
+   // Returns true if args[0] is only written by the code.
+   //
+   static bool IsLocRegDst(IR::Code code)
+   {
+      switch(code.base)
+      {
+      case IR::CodeBase::Add:
+      case IR::CodeBase::AddX:
+      case IR::CodeBase::BAnd:
+      case IR::CodeBase::BNot:
+      case IR::CodeBase::BOrI:
+      case IR::CodeBase::BOrX:
+      case IR::CodeBase::Bclo:
+      case IR::CodeBase::Bclz:
+      case IR::CodeBase::Bges:
+      case IR::CodeBase::Bget:
+      case IR::CodeBase::Call:
+      case IR::CodeBase::Casm:
+      case IR::CodeBase::CmpEQ:
+      case IR::CodeBase::CmpGE:
+      case IR::CodeBase::CmpGT:
+      case IR::CodeBase::CmpLE:
+      case IR::CodeBase::CmpLT:
+      case IR::CodeBase::CmpNE:
+      case IR::CodeBase::Cnat:
+      case IR::CodeBase::Cscr_IA:
+      case IR::CodeBase::Cscr_IS:
+      case IR::CodeBase::Cscr_SA:
+      case IR::CodeBase::Cscr_SS:
+      case IR::CodeBase::Cspe:
+      case IR::CodeBase::Div:
+      case IR::CodeBase::DivX:
+      case IR::CodeBase::LAnd:
+      case IR::CodeBase::LNot:
+      case IR::CodeBase::LOrI:
+      case IR::CodeBase::Mod:
+      case IR::CodeBase::Move:
+      case IR::CodeBase::Mul:
+      case IR::CodeBase::MulX:
+      case IR::CodeBase::Neg:
+      case IR::CodeBase::Pltn:
+      case IR::CodeBase::ShL:
+      case IR::CodeBase::ShR:
+      case IR::CodeBase::Sub:
+      case IR::CodeBase::SubX:
+         return true;
+
+      default:
+         return false;
+      }
+   }
+
+   //
+   // IsLocRegMod
+   //
+   // Returns true if args[argi] is both read and written by the code.
+   //
+   static bool IsLocRegMod(IR::Code code, std::size_t argi)
+   {
+      switch(code.base)
+      {
+      case IR::CodeBase::Bset:
+      case IR::CodeBase::Copy:
+      case IR::CodeBase::Tr:
+         return argi == 0;
+
+      case IR::CodeBase::Swap:
+         return argi <= 1;
+
+      default:
+         return false;
+      }
+   }
+
+   //
+   // GetLocRegUses
+   //
+   // Returns false if arg contains an access that cannot be analyzed.
+   //
+   static bool GetLocRegUses(std::vector<LocRegUse> &uses, IR::Arg &arg,
+      std::size_t stmnt, bool dst, bool mod)
+   {
+      switch(arg.a)
+      {
+      case IR::ArgBase::Cpy:
+      case IR::ArgBase::Lit:
+      case IR::ArgBase::Nul:
+      case IR::ArgBase::Stk:
+         return true;
+
+      case IR::ArgBase::LocReg:
+         {
+            auto &a = arg.aLocReg;
+
+            Core::FastU addr;
+            if(!GetLocRegAddr(a, addr))
+               return false;
+
+            if(!a.size) return true;
+
+            Core::FastU wb = Target::GetWordBytes();
+
+            uses.push_back({&arg, &a, addr, addr / wb,
+               (addr + a.size + wb - 1) / wb, stmnt, 0, dst || mod, mod});
+         }
+         return true;
+
+      #define GDCC_BC_ArgPtr1(name) case IR::ArgBase::name: \
+         return GetLocRegUses(uses, *arg.a##name.idx, stmnt, false, false);
+      #define GDCC_BC_ArgPtr2(name) case IR::ArgBase::name: \
+         return GetLocRegUses(uses, *arg.a##name.arr, stmnt, false, false) && \
+            GetLocRegUses(uses, *arg.a##name.idx, stmnt, false, false);
+      GDCC_BC_ArgPtr1(Aut)
+      GDCC_BC_ArgPtr1(Far)
+      GDCC_BC_ArgPtr1(Gen)
+      GDCC_BC_ArgPtr1(GblArs)
+      GDCC_BC_ArgPtr1(GblReg)
+      GDCC_BC_ArgPtr1(HubArs)
+      GDCC_BC_ArgPtr1(HubReg)
+      GDCC_BC_ArgPtr1(ModArs)
+      GDCC_BC_ArgPtr1(ModReg)
+      GDCC_BC_ArgPtr1(Sta)
+      GDCC_BC_ArgPtr1(StrArs)
+      GDCC_BC_ArgPtr1(Vaa)
+      GDCC_BC_ArgPtr2(GblArr)
+      GDCC_BC_ArgPtr2(HubArr)
+      GDCC_BC_ArgPtr2(LocArr)
+      GDCC_BC_ArgPtr2(ModArr)
+      GDCC_BC_ArgPtr2(StrArr)
+      #undef GDCC_BC_ArgPtr2
+      #undef GDCC_BC_ArgPtr1
+      }
+
+      return false;
+   }
+
+   //
+   // GetLocRegSlots
+   //
+   // Collects local register accesses and forms slots from overlapping
+   // ones. Each parameter word is also a slot, since parameters are
+   // defined on entry. Returns false if the function cannot be analyzed.
+   //
+   static bool GetLocRegSlots(IR::Flow &flow, IR::Function const &func,
+      std::vector<LocRegUse> &uses, std::vector<LocRegSlot> &slots)
+   {
+      std::size_t stmntN = flow.getStmntCount();
+
+      if(!stmntN)
+         return false;
+
+      for(std::size_t i = 0; i != stmntN; ++i)
+      {
+         auto st = flow.getStmnt(i);
+
+         for(std::size_t a = 0; a != st->args.size(); ++a)
+         {
+            if(!GetLocRegUses(uses, st->args[a], i,
+               a == 0 && IsLocRegDst(st->code), IsLocRegMod(st->code, a)))
+               return false;
+         }
+      }
+
+      std::vector<std::pair<Core::FastU, Core::FastU>> ranges;
+      for(Core::FastU i = 0; i != func.param; ++i)
+         ranges.emplace_back(i, i + 1);
+      for(auto const &use : uses)
+         ranges.emplace_back(use.lo, use.hi);
+
+      std::sort(ranges.begin(), ranges.end());
+
+      for(auto const &range : ranges)
+      {
+         if(!slots.empty() && range.first < slots.back().hi)
+            slots.back().hi = std::max(slots.back().hi, range.second);
+         else
+            slots.push_back({range.first, range.second, 0, range.first < func.param});
+      }
+
+      if(slots.empty() || slots.size() > 4096)
+         return false;
+
+      for(auto &use : uses)
+         use.slot = FindLocRegSlot(slots, use.lo);
+
+      return true;
+   }
+
+   //
+   // GetLocRegReserve
+   //
+   // A register for the stack pointer might be reserved after the others.
+   //
+   static Core::FastU GetLocRegReserve(IR::Function const &func)
+   {
+      return func.allocAut &&
+         (func.ctype == IR::CallType::ScriptI ||
+          func.ctype == IR::CallType::ScriptS ||
+          func.ctype == IR::CallType::StkCall);
+   }
+
+   //
+   // IsPropPure
+   //
+   // Returns true if the code has no effect other than writing args[0].
+   //
+   static bool IsPropPure(IR::Code code)
+   {
+      switch(code.base)
+      {
+      case IR::CodeBase::Add:
+      case IR::CodeBase::BAnd:
+      case IR::CodeBase::BNot:
+      case IR::CodeBase::BOrI:
+      case IR::CodeBase::BOrX:
+      case IR::CodeBase::CmpEQ:
+      case IR::CodeBase::CmpGE:
+      case IR::CodeBase::CmpGT:
+      case IR::CodeBase::CmpLE:
+      case IR::CodeBase::CmpLT:
+      case IR::CodeBase::CmpNE:
+      case IR::CodeBase::LAnd:
+      case IR::CodeBase::LNot:
+      case IR::CodeBase::LOrI:
+      case IR::CodeBase::Move:
+      case IR::CodeBase::Mul:
+      case IR::CodeBase::Neg:
+      case IR::CodeBase::ShL:
+      case IR::CodeBase::ShR:
+      case IR::CodeBase::Sub:
+         return true;
+
+      default:
+         return false;
+      }
+   }
+
+   //
+   // IsPropSrc
+   //
+   // Returns true if args[argi] of code can be replaced by any value.
+   //
+   static bool IsPropSrc(IR::Code code, std::size_t argi)
+   {
+      switch(code.base)
+      {
+      case IR::CodeBase::Div:
+      case IR::CodeBase::Mod:
+         return argi != 0;
+
+      case IR::CodeBase::Jcnd_Nil:
+      case IR::CodeBase::Jcnd_Tru:
+         return argi == 0;
+
+      default:
+         return argi != 0 && IsPropPure(code);
+      }
+   }
+
+   //
+   // GetPropValue
+   //
+   // Returns the fixed-point value of a literal argument, if any.
+   //
+   static IR::Value_Fixed const *GetPropValue(IR::Arg const &arg, IR::Value &val)
+   {
+      if(arg.a != IR::ArgBase::Lit || arg.aLit.off || !arg.aLit.value->isValue())
+         return nullptr;
+
+      val = arg.aLit.value->getValue();
+      if(val.v != IR::ValueBase::Fixed || val.vFixed.vtype.bitsF ||
+         val.vFixed.vtype.satur)
+         return nullptr;
+
+      return &val.vFixed;
+   }
+
+   //
+   // FoldPropStmnt
+   //
+   // Replaces an integral operation on literals with a Move of its result.
+   //
+   static bool FoldPropStmnt(IR::Statement *st)
+   {
+      switch(st->code.base)
+      {
+      case IR::CodeBase::Add:
+      case IR::CodeBase::BAnd:
+      case IR::CodeBase::BOrI:
+      case IR::CodeBase::BOrX:
+      case IR::CodeBase::Mul:
+      case IR::CodeBase::Sub:
+         break;
+
+      default:
+         return false;
+      }
+
+      auto type = st->code.type;
+      if(type.size() > 1 || (type.size() && type[0] != 'I' && type[0] != 'U'))
+         return false;
+
+      if(st->args.size() != 3)
+         return false;
+
+      IR::Value lv, rv;
+      auto l = GetPropValue(st->args[1], lv);
+      auto r = GetPropValue(st->args[2], rv);
+
+      Core::FastU size = st->args[0].getSize();
+      if(!l || !r || !(l->vtype == r->vtype) ||
+         st->args[1].aLit.size != size || st->args[2].aLit.size != size)
+         return false;
+
+      IR::Value_Fixed v;
+      switch(st->code.base)
+      {
+      case IR::CodeBase::Add:  v = *l + *r; break;
+      case IR::CodeBase::BAnd: v = *l & *r; break;
+      case IR::CodeBase::BOrI: v = *l | *r; break;
+      case IR::CodeBase::BOrX: v = *l ^ *r; break;
+      case IR::CodeBase::Mul:  v = *l * *r; break;
+      case IR::CodeBase::Sub:  v = *l - *r; break;
+      default: return false;
+      }
+
+      Core::Array<IR::Arg> args{2};
+      args[0] = std::move(st->args[0]);
+      args[1] = IR::Arg_Lit(size, IR::ExpCreate_Value(std::move(v), st->pos));
+
+      st->code = IR::CodeBase::Move;
+      st->args = std::move(args);
+
+      return true;
+   }
+
+   //
+   // SetLocRegAccess
+   //
+   // Reports a statement's accesses to slots. This is done from the
+   // statement itself, so that edited statements are seen as they are.
+   //
+   static void SetLocRegAccess(IR::Flow &flow, std::vector<LocRegSlot> const &slots)
+   {
+      flow.setAccess(slots.size(), [&flow, &slots](std::size_t i, IR::FlowAccess &acc)
+      {
+         auto st = flow.getStmnt(i);
+
+         std::vector<LocRegUse> uses;
+         for(std::size_t a = 0; a != st->args.size(); ++a)
+            GetLocRegUses(uses, st->args[a], i,
+               a == 0 && IsLocRegDst(st->code), IsLocRegMod(st->code, a));
+
+         for(auto const &use : uses)
+         {
+            auto  s    = FindLocRegSlot(slots, use.lo);
+            auto &slot = slots[s];
+
+            if(!use.dst)
+               acc.use.push_back(s);
+            else if(use.mod)
+               acc.mod.push_back(s), acc.use.push_back(s);
+            else if(use.lo == slot.lo && use.hi == slot.hi)
+               acc.def.push_back(s);
+            else
+               acc.mod.push_back(s);
+         }
+      });
+   }
+
+   //
+   // GetArgWords
+   //
+   static Core::FastU GetArgWords(IR::Arg const &arg)
+   {
+      Core::FastU wb = Target::GetWordBytes();
+      return (arg.getSize() + wb - 1) / wb;
+   }
+
+   //
+   // GetStkWords
+   //
+   // Adds the words popped by reading arg. Returns false if not known.
+   //
+   static bool GetStkWords(IR::Arg const &arg, Core::FastU &words)
+   {
+      switch(arg.a)
+      {
+      case IR::ArgBase::Cpy:
+         return false;
+
+      case IR::ArgBase::Stk:
+         words += GetArgWords(arg);
+         return true;
+
+      #define GDCC_BC_ArgPtr1(name) case IR::ArgBase::name: \
+         return GetStkWords(*arg.a##name.idx, words);
+      #define GDCC_BC_ArgPtr2(name) case IR::ArgBase::name: \
+         return GetStkWords(*arg.a##name.arr, words) && \
+            GetStkWords(*arg.a##name.idx, words);
+      GDCC_BC_ArgPtr1(Aut)
+      GDCC_BC_ArgPtr1(Far)
+      GDCC_BC_ArgPtr1(Gen)
+      GDCC_BC_ArgPtr1(GblArs)
+      GDCC_BC_ArgPtr1(GblReg)
+      GDCC_BC_ArgPtr1(HubArs)
+      GDCC_BC_ArgPtr1(HubReg)
+      GDCC_BC_ArgPtr1(LocReg)
+      GDCC_BC_ArgPtr1(ModArs)
+      GDCC_BC_ArgPtr1(ModReg)
+      GDCC_BC_ArgPtr1(Sta)
+      GDCC_BC_ArgPtr1(StrArs)
+      GDCC_BC_ArgPtr1(Vaa)
+      GDCC_BC_ArgPtr2(GblArr)
+      GDCC_BC_ArgPtr2(HubArr)
+      GDCC_BC_ArgPtr2(LocArr)
+      GDCC_BC_ArgPtr2(ModArr)
+      GDCC_BC_ArgPtr2(StrArr)
+      #undef GDCC_BC_ArgPtr2
+      #undef GDCC_BC_ArgPtr1
+
+      default:
+         return true;
+      }
+   }
+
+   //
+   // SetInlineArg
+   //
+   // Moves a callee's argument into the caller's registers and labels. If
+   // map is null, only checks that this is possible.
+   //
+   static bool SetInlineArg(IR::Arg &arg, IR::Function const &callee,
+      InlineMap const *map)
+   {
+      switch(arg.a)
+      {
+      case IR::ArgBase::Aut:
+      case IR::ArgBase::LocArr:
+      case IR::ArgBase::Vaa:
+         return false;
+
+      case IR::ArgBase::Lit:
+         {
+            auto exp = dynamic_cast<IR::Exp_Glyph const *>(&*arg.aLit.value);
+            if(!exp)
+               return true;
+
+            if(exp->glyph == callee.label)
+               return false;
+
+            if(map)
+            {
+               auto itr = map->labs.find(exp->glyph);
+               if(itr != map->labs.end())
+                  arg.aLit.value = IR::ExpCreate_Glyph({map->prog, itr->second},
+                     arg.aLit.value->pos);
+            }
+         }
+         return true;
+
+      case IR::ArgBase::LocReg:
+         {
+            auto &a = arg.aLocReg;
+
+            Core::FastU addr;
+            if(!GetLocRegAddr(a, addr))
+               return false;
+
+            Core::FastU wb = Target::GetWordBytes();
+            if((addr + a.size + wb - 1) / wb > callee.localReg)
+               return false;
+
+            if(map)
+            {
+               addr += map->base * wb;
+
+               *a.idx = IR::Arg_Lit(a.idx->aLit.size,
+                  IR::ExpCreate_Value(IR::Value_Fixed(Core::NumberCast<Core::Integ>(addr),
+                     IR::Type_Fixed{Target::GetWordBits(), 0, false, false}),
+                     a.idx->aLit.value->pos));
+               a.off = 0;
+            }
+         }
+         return true;
+
+      #define GDCC_BC_ArgPtr1(name) case IR::ArgBase::name: \
+         return SetInlineArg(*arg.a##name.idx, callee, map);
+      #define GDCC_BC_ArgPtr2(name) case IR::ArgBase::name: \
+         return SetInlineArg(*arg.a##name.arr, callee, map) && \
+            SetInlineArg(*arg.a##name.idx, callee, map);
+      GDCC_BC_ArgPtr1(Far)
+      GDCC_BC_ArgPtr1(Gen)
+      GDCC_BC_ArgPtr1(GblArs)
+      GDCC_BC_ArgPtr1(GblReg)
+      GDCC_BC_ArgPtr1(HubArs)
+      GDCC_BC_ArgPtr1(HubReg)
+      GDCC_BC_ArgPtr1(ModArs)
+      GDCC_BC_ArgPtr1(ModReg)
+      GDCC_BC_ArgPtr1(Sta)
+      GDCC_BC_ArgPtr1(StrArs)
+      GDCC_BC_ArgPtr2(GblArr)
+      GDCC_BC_ArgPtr2(HubArr)
+      GDCC_BC_ArgPtr2(ModArr)
+      GDCC_BC_ArgPtr2(StrArr)
+      #undef GDCC_BC_ArgPtr2
+      #undef GDCC_BC_ArgPtr1
+
+      default:
+         return true;
+      }
+   }
+
+   //
+   // IsInlineCode
+   //
+   // Returns true if the code does not depend on the function it is in.
+   //
+   static bool IsInlineCode(IR::Code code)
+   {
+      switch(code.base)
+      {
+      case IR::CodeBase::Call:
+      case IR::CodeBase::Cscr_IA:
+      case IR::CodeBase::Cscr_IS:
+      case IR::CodeBase::Cscr_SA:
+      case IR::CodeBase::Cscr_SS:
+      case IR::CodeBase::Jdyn:
+      case IR::CodeBase::Jfar_Pro:
+      case IR::CodeBase::Jfar_Set:
+      case IR::CodeBase::Jfar_Sta:
+      case IR::CodeBase::Pltn:
+      case IR::CodeBase::Rjnk:
+      case IR::CodeBase::Xcod_SID:
+         return false;
+
+      default:
+         return true;
+      }
+   }
+
+   //
+   // IsLocRegInit
+   //
+   // Registers are zeroed on each call. Returns true if the function does
+   // not rely on that, reading no register other than parameters before
+   // writing it.
+   //
+   static bool IsLocRegInit(IR::Function &fn)
+   {
+      IR::Flow                flow{fn.block};
+      std::vector<LocRegUse>  uses;
+      std::vector<LocRegSlot> slots;
+
+      if(!GetLocRegSlots(flow, fn, uses, slots))
+         return false;
+
+      SetLocRegAccess(flow, slots);
+
+      for(std::size_t s = 0; s != slots.size(); ++s)
+         if(!slots[s].pin && flow.isLiveIn(0, s)) return false;
+
+      return true;
+   }
+
+   //
+   // IsInlineFunc
+   //
+   // Returns true if calls to the function can be replaced by its body.
+   // Such functions make no calls, have no automatic storage, and only
+   // access registers at known addresses.
+   //
+   static bool IsInlineFunc(IR::Function &callee)
+   {
+      if(!callee.defin || callee.inlineNever || callee.allocAut ||
+         !callee.localArr.empty())
+         return false;
+
+      if(callee.ctype != IR::CallType::StdCall &&
+         callee.ctype != IR::CallType::StkCall)
+         return false;
+
+      if(callee.block.empty() || (!callee.inlineAlways &&
+         callee.block.size() > OptInlineSize))
+         return false;
+
+      // Control must not leave the end of the body.
+      if(std::prev(callee.block.end())->code != IR::CodeBase::Retn)
+         return false;
+
+      for(auto &st : callee.block)
+      {
+         if(!IsInlineCode(st.code))
+            return false;
+
+         if(st.code == IR::CodeBase::Retn && st.args.size() > 1)
+            return false;
+
+         for(auto &arg : st.args)
+            if(!SetInlineArg(arg, callee, nullptr)) return false;
+      }
+
+      return IsLocRegInit(callee);
+   }
+
+   //
+   // IsInlineCaller
+   //
+   // Returns true if the function uses no registers from base up.
+   //
+   static bool IsInlineCaller(IR::Function &fn, Core::FastU base)
+   {
+      std::vector<LocRegUse> uses;
+
+      for(auto &st : fn.block) for(auto &arg : st.args)
+         if(!GetLocRegUses(uses, arg, 0, false, false)) return false;
+
+      return std::all_of(uses.begin(), uses.end(),
+         [base](LocRegUse const &use) {return use.hi <= base;});
+   }
+
+   //
+   // FindInlinePltn
+   //
+   // Finds the statement that pushed a call's stack pointer argument, if
+   // it is a Pltn that can be removed. words is the number of words pushed
+   // after the stack pointer.
+   //
+   static IR::Statement *FindInlinePltn(IR::Block &block, IR::Statement *call,
+      Core::FastU words)
+   {
+      for(auto st = call->prev, end = &*block.end(); st != end; st = st->prev)
+      {
+         if(!IsLocRegDst(st->code) || st->args.empty())
+            return nullptr;
+
+         Core::FastU push = 0, pop = 0;
+         for(std::size_t a = 0; a != st->args.size(); ++a)
+         {
+            if(a == 0 && st->args[a].a == IR::ArgBase::Stk)
+               push = GetArgWords(st->args[a]);
+            else if(!GetStkWords(st->args[a], pop))
+               return nullptr;
+         }
+
+         if(!words && push)
+         {
+            if(st->code == IR::CodeBase::Pltn && push == 1 && !pop)
+               return st;
+
+            return nullptr;
+         }
+
+         // Jumps into the sequence might push something else.
+         if(!st->labs.empty() || push > words)
+            return nullptr;
+
+         words = words - push + pop;
+      }
+
+      return nullptr;
+   }
+
+   //
+   // GetTailRetn
+   //
+   // If call is a call of fn to itself whose result is immediately
+   // returned, returns the Retn.
+   //
+   static IR::Statement *GetTailRetn(IR::Function const &fn, IR::Statement *call,
+      IR::Statement *end)
+   {
+      if(call->code != IR::CodeBase::Call || !call->labs.empty() ||
+         call->args.size() < 2 || call->args[1].a != IR::ArgBase::Lit)
+         return nullptr;
+
+      auto exp = dynamic_cast<IR::Exp_Glyph const *>(&*call->args[1].aLit.value);
+      if(!exp || exp->glyph != fn.glyph)
+         return nullptr;
+
+      auto &dst  = call->args[0];
+      auto  retn = call->next;
+
+      if(retn != end && retn->code == IR::CodeBase::Jfar_Pro && retn->labs.empty())
+         retn = retn->next;
+
+      if(retn == end || retn->code != IR::CodeBase::Retn || dst.a != IR::ArgBase::Stk)
+         return nullptr;
+
+      if(retn->args.empty() ? dst.getSize() != 0 : retn->args.size() != 1 ||
+         retn->args[0].a != IR::ArgBase::Stk || retn->args[0].getSize() != dst.getSize())
+         return nullptr;
+
+      // Arguments must not read parameters, which are stored in order.
+      Core::FastU wb = Target::GetWordBytes(), words = 0;
+      for(std::size_t a = 2; a != call->args.size(); ++a)
+      {
+         auto &arg = call->args[a];
+
+         if(arg.a == IR::ArgBase::LocReg)
+         {
+            Core::FastU addr;
+            if(!GetLocRegAddr(arg.aLocReg, addr) || addr / wb < fn.param)
+               return nullptr;
+         }
+         else if(arg.a != IR::ArgBase::Lit && arg.a != IR::ArgBase::Stk)
+            return nullptr;
+
+         words += GetArgWords(arg);
+      }
+
+      if(words != fn.param)
+         return nullptr;
+
+      if(Target::IsCallAutoProp(fn.ctype) &&
+         (call->args.size() < 3 || GetArgWords(call->args[2]) != 1))
+         return nullptr;
+
+      return retn;
+   }
+
+   //
+   // ExpandInline
+   //
+   // Replaces a call with the callee's body, using registers from base.
+   // Returns the statement after the expansion, or null if the call was
+   // left unchanged.
+   //
+   static IR::Statement *ExpandInline(IR::Program &prog, IR::Function &fn,
+      IR::Statement *call, IR::Function const &callee, Core::FastU base)
+   {
+      auto &block = fn.block;
+      auto  end   = &*block.end();
+      auto &dst   = call->args[0];
+
+      if(!call->labs.empty() || call->args.size() < 2)
+         return nullptr;
+
+      if(dst.a != IR::ArgBase::Nul && dst.a != IR::ArgBase::Stk)
+         return nullptr;
+
+      // Arguments must be stored to parameters in order.
+      Core::FastU words = 0, stkWords = 0;
+      for(std::size_t a = 2; a != call->args.size(); ++a)
+      {
+         auto &arg = call->args[a];
+
+         if(arg.a == IR::ArgBase::Stk)
+            stkWords += GetArgWords(arg);
+         else if(arg.a != IR::ArgBase::Lit && (arg.a != IR::ArgBase::LocReg ||
+            arg.aLocReg.idx->a != IR::ArgBase::Lit))
+            return nullptr;
+
+         words += GetArgWords(arg);
+      }
+
+      if(words != callee.param)
+         return nullptr;
+
+      // The stack pointer parameter is not used by the body.
+      bool autoProp = Target::IsCallAutoProp(callee.ctype);
+      if(autoProp && (call->args.size() < 3 || GetArgWords(call->args[2]) != 1))
+         return nullptr;
+
+      for(auto const &st : callee.block)
+      {
+         if(st.code != IR::CodeBase::Retn || dst.a == IR::ArgBase::Nul)
+            continue;
+
+         if(dst.getSize() != (st.args.empty() ? 0 : st.args[0].getSize()))
+            return nullptr;
+      }
+
+      IR::Statement *pltn = nullptr;
+      if(autoProp && call->args[2].a == IR::ArgBase::Stk)
+         pltn = FindInlinePltn(block, call, stkWords - 1);
+
+      // Find an unused label prefix.
+      Core::StringGen gen{fn.glyph, "$inline$"};
+      Core::StringGen labGen;
+      do labGen.reset(gen(), "$");
+      while(prog.findGlyphData(labGen(0)));
+
+      InlineMap map{&prog, base, {}};
+      for(auto const &st : callee.block)
+         for(auto const &lab : st.labs) map.labs.emplace(lab, labGen());
+
+      Core::String labEnd = labGen(0);
+      prog.getGlyphData(labEnd);
+      for(auto const &lab : map.labs)
+         prog.getGlyphData(lab.second);
+
+      std::vector<Core::String> labs;
+
+      if(pltn)
+      {
+         if(pltn->next == call)
+            labs.assign(pltn->labs.begin(), pltn->labs.end());
+         else if(!pltn->labs.empty())
+            pltn->next->labs += pltn->labs;
+         delete pltn;
+      }
+
+      auto origin = block.getOrigin();
+
+      auto addStmnt = [&](Core::Origin pos, IR::Code code, Core::Array<IR::Arg> &&args)
+      {
+         for(auto const &lab : labs) block.addLabel(lab);
+         labs.clear();
+
+         block.setOrigin(pos);
+         block.addStmntArgs(call, code, std::move(args));
+      };
+
+      // Store arguments, last first.
+      Core::FastU wb = Target::GetWordBytes();
+      for(std::size_t a = call->args.size(); a-- != 2;)
+      {
+         auto &arg = call->args[a];
+
+         words -= GetArgWords(arg);
+
+         Core::Array<IR::Arg> args{2};
+         if(autoProp && a == 2)
+         {
+            if(pltn || arg.a != IR::ArgBase::Stk)
+               continue;
+
+            args[0] = IR::Arg_Nul(arg.getSize());
+         }
+         else
+         {
+            args[0] = IR::Arg_LocReg(arg.getSize(), IR::Arg_Lit(wb,
+               IR::ExpCreate_Value(IR::Value_Fixed(
+                  Core::NumberCast<Core::Integ>((base + words) * wb),
+                  IR::Type_Fixed{Target::GetWordBits(), 0, false, false}),
+                  call->pos)));
+         }
+
+         args[1] = std::move(arg);
+         addStmnt(call->pos, IR::CodeBase::Move, std::move(args));
+      }
+
+      // Copy body.
+      bool useEnd = false;
+      for(auto itr = callee.block.begin(), last = std::prev(callee.block.end());
+         itr != callee.block.end(); ++itr)
+      {
+         for(auto const &lab : itr->labs)
+            labs.push_back(map.labs[lab]);
+
+         Core::Array<IR::Arg> args(itr->args);
+         for(auto &arg : args)
+            SetInlineArg(arg, callee, &map);
+
+         if(itr->code == IR::CodeBase::Retn)
+         {
+            if(!args.empty() && !(dst.a == IR::ArgBase::Stk && args[0].a == IR::ArgBase::Stk))
+            {
+               Core::FastU pop = 0;
+               if(dst.a != IR::ArgBase::Nul || (GetStkWords(args[0], pop) && pop))
+               {
+                  Core::Array<IR::Arg> move{2};
+                  move[0] = dst.a == IR::ArgBase::Nul ? IR::Arg(IR::Arg_Nul(args[0].getSize())) : dst;
+                  move[1] = std::move(args[0]);
+                  addStmnt(itr->pos, IR::CodeBase::Move, std::move(move));
+               }
+            }
+
+            if(itr != last)
+            {
+               useEnd = true;
+               addStmnt(itr->pos, IR::CodeBase::Jump,
+                  {IR::Arg_Lit(wb, IR::ExpCreate_Glyph({prog, labEnd}, itr->pos))});
+            }
+         }
+         else
+            addStmnt(itr->pos, itr->code, std::move(args));
+      }
+
+      block.setOrigin(origin);
+
+      // Remove the call and its far jump check.
+      if(auto next = call->next; next != end && next->code == IR::CodeBase::Jfar_Pro)
+      {
+         labs.insert(labs.end(), next->labs.begin(), next->labs.end());
+         delete next;
+      }
+
+      if(useEnd)
+         labs.push_back(labEnd);
+
+      auto cont = call->next;
+      delete call;
+
+      if(!labs.empty())
+      {
+         if(cont == end)
+         {
+            for(auto const &lab : labs) block.addLabel(lab);
+            block.addStmnt(IR::CodeBase::Nop);
+            cont = end->prev;
+         }
+         else
+            cont->labs += Core::Array<Core::String>(labs.begin(), labs.end());
+      }
+
+      return cont;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // Info::optFunc
+   //
+   void Info::optFunc()
+   {
+      optFunc_Tail();
+      optBlock(func->block);
+      optFunc_Prop();
+      optFunc_LocReg();
+   }
+
+   //
+   // Info::optFunc_Prop
+   //
+   // Replaces reads of local registers whose reaching definitions are all
+   // Moves of the same literal, or a single Move from another register
+   // that is unchanged since. Afterwards, operations on literals are
+   // folded and pure stores to registers that are not live are removed.
+   //
+   void Info::optFunc_Prop()
+   {
+      if(!OptProp || !func->defin)
+         return;
+
+      IR::Flow               flow{func->block};
+      std::vector<LocRegUse>  uses;
+      std::vector<LocRegSlot> slots;
+
+      if(!GetLocRegSlots(flow, *func, uses, slots))
+         return;
+
+      SetLocRegAccess(flow, slots);
+
+      std::size_t stmntN = flow.getStmntCount();
+      Core::FastU wb     = Target::GetWordBytes();
+
+      // Returns the source of a Move that completely writes the same
+      // register as use, or null.
+      auto getMoveSrc = [&](std::size_t i, LocRegUse const &use) -> IR::Arg const *
+      {
+         if(i == stmntN)
+            return nullptr;
+
+         auto st = flow.getStmnt(i);
+         if(st->code != IR::CodeBase::Move || st->args[0].a != IR::ArgBase::LocReg)
+            return nullptr;
+
+         Core::FastU addr;
+         if(!GetLocRegAddr(st->args[0].aLocReg, addr) || addr != use.addr ||
+            st->args[0].aLocReg.size != use.arg->size)
+            return nullptr;
+
+         return &st->args[1];
+      };
+
+      // Returns true if the statement only partly writes the slot.
+      auto isModDef = [&](std::size_t i, std::size_t slot)
+      {
+         if(i == stmntN)
+            return false;
+
+         auto const &mod = flow.getAccess(i).mod;
+         return std::find(mod.begin(), mod.end(), slot) != mod.end();
+      };
+
+      // Propagate.
+      std::vector<bool>        edited(stmntN);
+      std::vector<std::size_t> defs, defsCpy, defsUse;
+      for(auto &use : uses)
+      {
+         auto st = flow.getStmnt(use.stmnt);
+
+         if(use.dst)
+            continue;
+
+         // Registers used directly as arguments must be in a source
+         // position. Pointer indexes are always read.
+         auto arg = std::find_if(st->args.begin(), st->args.end(),
+            [&](IR::Arg const &a) {return use.outer == &a;});
+         if(arg != st->args.end() && !IsPropSrc(st->code, arg - st->args.begin()))
+            continue;
+
+         auto const &slot = slots[use.slot];
+         if(use.lo != slot.lo || use.hi != slot.hi)
+            continue;
+
+         defs.clear();
+         flow.getReachingDefs(use.stmnt, use.slot, defs);
+
+         // Partial writes leave part of the old value.
+         if(std::any_of(defs.begin(), defs.end(),
+            [&](std::size_t d) {return isModDef(d, use.slot);}))
+            continue;
+
+         IR::Arg const *src = nullptr;
+         for(auto d : defs)
+         {
+            auto s = getMoveSrc(d, use);
+            if(!s || (src && !(*s == *src))) {src = nullptr; break;}
+            src = s;
+         }
+
+         if(!src)
+            continue;
+
+         if(src->a == IR::ArgBase::Lit)
+         {
+            // Branches are only given literals that will be folded.
+            IR::Value val;
+            if((st->code == IR::CodeBase::Jcnd_Nil || st->code == IR::CodeBase::Jcnd_Tru) &&
+               !GetPropValue(*src, val))
+               continue;
+         }
+         else if(src->a == IR::ArgBase::LocReg && defs.size() == 1)
+         {
+            // The copied register must have the same definitions at both
+            // the copy and the use.
+            Core::FastU addr;
+            if(!GetLocRegAddr(src->aLocReg, addr))
+               continue;
+
+            auto        cpy     = FindLocRegSlot(slots, addr / wb);
+            auto const &cpySlot = slots[cpy];
+            if(cpy == use.slot || cpySlot.lo != addr / wb ||
+               cpySlot.hi != (addr + src->aLocReg.size + wb - 1) / wb)
+               continue;
+
+            defsCpy.clear(); flow.getReachingDefs(defs[0],   cpy, defsCpy);
+            defsUse.clear(); flow.getReachingDefs(use.stmnt, cpy, defsUse);
+            std::sort(defsCpy.begin(), defsCpy.end());
+            std::sort(defsUse.begin(), defsUse.end());
+            if(defsCpy != defsUse)
+               continue;
+         }
+         else
+            continue;
+
+         *use.outer = *src;
+         edited[use.stmnt] = true;
+      }
+
+      // Fold, then find stores that are no longer needed.
+      for(std::size_t i = 0; i != stmntN; ++i)
+      {
+         if(edited[i])
+         {
+            FoldPropStmnt(flow.getStmnt(i));
+            flow.invalidate(flow.getStmnt(i));
+         }
+      }
+
+      std::vector<bool> dead(stmntN);
+      for(std::size_t i = 0; i != stmntN; ++i)
+      {
+         auto st = flow.getStmnt(i);
+
+         if(!IsPropPure(st->code) || st->args.empty() ||
+            st->args[0].a != IR::ArgBase::LocReg)
+            continue;
+
+         Core::FastU addr;
+         if(!GetLocRegAddr(st->args[0].aLocReg, addr))
+            continue;
+
+         auto        s    = FindLocRegSlot(slots, addr / wb);
+         auto const &slot = slots[s];
+         if(slot.lo != addr / wb ||
+            slot.hi != (addr + st->args[0].aLocReg.size + wb - 1) / wb ||
+            flow.isLiveOut(i, s))
+            continue;
+
+         // Sources must not have effects of their own.
+         dead[i] = std::all_of(st->args.begin() + 1, st->args.end(),
+            [](IR::Arg const &a) {return a.a == IR::ArgBase::Lit ||
+               (a.a == IR::ArgBase::LocReg && a.aLocReg.idx->a == IR::ArgBase::Lit);});
+      }
+
+      // Remove dead stores and fold constant branches.
+      for(std::size_t i = stmntN; i--;)
+      {
+         auto st = flow.getStmnt(i);
+
+         if(st->code == IR::CodeBase::Jcnd_Nil || st->code == IR::CodeBase::Jcnd_Tru)
+         {
+            IR::Value val;
+            auto v = GetPropValue(st->args[0], val);
+            if(!v)
+               continue;
+
+            if(static_cast<bool>(*v) == (st->code == IR::CodeBase::Jcnd_Tru))
+            {
+               Core::Array<IR::Arg> args{1};
+               args[0] = std::move(st->args[1]);
+
+               st->code = IR::CodeBase::Jump;
+               st->args = std::move(args);
+               continue;
+            }
+         }
+         else if(!dead[i])
+            continue;
+
+         // A label on the last statement has nowhere to go.
+         if(!st->labs.empty())
+         {
+            if(i + 1 == stmntN) continue;
+            st->next->labs += st->labs;
+         }
+
+         delete st;
+      }
+   }
+
+   //
+   // Info::optObj
+   //
+   // Local register objects already have fixed addresses, so back their
+   // glyphs early for optFunc_LocReg. Other objects are left for gen.
+   //
+   void Info::optObj()
+   {
+      if(obj->space.base != IR::AddrBase::LocReg || obj->alloc)
+         return;
+
+      auto &data = prog->getGlyphData(obj->glyph);
+
+      if(data.value || data.type.t != IR::TypeBase::Point)
+         return;
+
+      data.value = IR::ExpCreate_Value(IR::Value_Point(obj->value,
+         data.type.tPoint.reprB, data.type.tPoint.reprN, data.type.tPoint), {nullptr, 0});
+   }
+
+   //
+   // Info::optFunc_LocReg
+   //
+   // Packs local registers that are never live at the same time into the
+   // same words. Liveness is computed per statement over the function's
+   // control flow, and registers are assigned first-fit.
+   //
+   void Info::optFunc_LocReg()
+   {
+      if(!OptLocalReg || !func->defin)
+         return;
+
+      IR::Flow               flow{func->block};
+      std::vector<LocRegUse>  uses;
+      std::vector<LocRegSlot> slots;
+
+      if(!GetLocRegSlots(flow, *func, uses, slots))
+         return;
+
+      std::size_t slotN = slots.size();
+
+      Core::FastU reserve = GetLocRegReserve(*func);
+
+      Core::FastU regMax = func->localReg - reserve;
+      if(slots.back().hi > regMax && slots.back().hi > func->param)
+         return;
+
+      SetLocRegAccess(flow, slots);
+
+      auto const &liveIn  = flow.getLiveIn();
+      auto const &liveOut = flow.getLiveOut();
+
+      // Build interference.
+      std::vector<bool> conflict(slotN * slotN);
+      auto setConflict = [&](std::size_t l, std::size_t r)
+      {
+         if(l != r) conflict[l * slotN + r] = conflict[r * slotN + l] = true;
+      };
+
+      for(auto useItr = uses.begin(), useEnd = uses.end(); useItr != useEnd;)
+      {
+         auto i = useItr->stmnt;
+         auto next = useItr;
+         while(next != useEnd && next->stmnt == i) ++next;
+
+         // Everything in one statement, whether read or written, must be
+         // distinct, since words may be written before others are read.
+         for(auto l = useItr; l != next; ++l)
+         {
+            for(auto r = useItr; r != next; ++r)
+               setConflict(l->slot, r->slot);
+
+            for(std::size_t s = 0; s != slotN; ++s)
+               if(liveOut.test(i, s)) setConflict(l->slot, s);
+         }
+
+         useItr = next;
+      }
+
+      // Anything live on entry is treated as live everywhere. This keeps
+      // parameters and the initial values of registers intact.
+      bool autoProp = Target::IsCallAutoProp(func->ctype);
+      for(std::size_t s = 0; s != slotN; ++s)
+      {
+         if(liveIn.test(0, s) || (autoProp && slots[s].lo == 0))
+            for(std::size_t t = 0; t != slotN; ++t) setConflict(s, t);
+         else if(slots[s].pin)
+         {
+            for(std::size_t t = 0; t != slotN; ++t)
+               if(slots[t].pin) setConflict(s, t);
+         }
+      }
+
+      // Assign words, keeping parameters in place.
+      Core::FastU regTop = func->param;
+      std::vector<std::pair<Core::FastU, Core::FastU>> taken;
+      for(std::size_t s = 0; s != slotN; ++s)
+      {
+         auto &slot = slots[s];
+
+         if(slot.pin)
+         {
+            slot.loNew = slot.lo;
+            regTop = std::max(regTop, slot.hi);
+            continue;
+         }
+
+         taken.clear();
+         for(std::size_t t = 0; t != slotN; ++t)
+         {
+            if(conflict[s * slotN + t] && (slots[t].pin || t < s))
+               taken.emplace_back(slots[t].loNew, slots[t].loNew + slots[t].hi - slots[t].lo);
+         }
+
+         std::sort(taken.begin(), taken.end());
+
+         Core::FastU lo = 0, size = slot.hi - slot.lo;
+         for(auto const &t : taken)
+         {
+            if(lo + size <= t.first) break;
+            lo = std::max(lo, t.second);
+         }
+
+         slot.loNew = lo;
+         regTop = std::max(regTop, lo + size);
+      }
+
+      if(regTop + reserve >= func->localReg)
+         return;
+
+      // Rewrite accesses.
+      Core::FastU wb = Target::GetWordBytes();
+      for(auto const &use : uses)
+      {
+         auto const &slot = slots[use.slot];
+         Core::FastU addr = use.addr + (slot.loNew - slot.lo) * wb;
+
+         *use.arg->idx = IR::Arg_Lit(use.arg->idx->aLit.size,
+            IR::ExpCreate_Value(IR::Value_Fixed(Core::NumberCast<Core::Integ>(addr),
+               IR::Type_Fixed{Target::GetWordBits(), 0, false, false}),
+               use.arg->idx->aLit.value->pos));
+         use.arg->off = 0;
+      }
+
+      func->localReg = regTop + reserve;
+   }
+
+   //
+   // Info::optFunc_Tail
+   //
+   // Replaces calls of a function to itself whose result is immediately
+   // returned with stores to its parameters and a jump to its start. This
+   // is only done without automatic storage, so that the function's state
+   // is entirely in its registers.
+   //
+   void Info::optFunc_Tail()
+   {
+      if(!OptTailCall || !func->defin || func->allocAut || !func->localArr.empty())
+         return;
+
+      if(func->ctype != IR::CallType::StdCall && func->ctype != IR::CallType::StkCall)
+         return;
+
+      auto &body = func->block;
+      auto  end  = &*body.end();
+
+      std::vector<IR::Statement *> calls;
+      for(auto &st : body)
+      {
+         if(st.code == IR::CodeBase::Jfar_Set || st.code == IR::CodeBase::Jfar_Sta)
+            return;
+
+         for(auto &arg : st.args)
+            if(!SetInlineArg(arg, *func, nullptr)) return;
+
+         if(GetTailRetn(*func, &st, end))
+            calls.push_back(&st);
+      }
+
+      if(calls.empty() || !IsLocRegInit(*func))
+         return;
+
+      // Label the start of the body, after any preamble.
+      Core::String labEntry = func->label + "$tail";
+      auto         first    = &*body.begin();
+      if(std::find(first->labs.begin(), first->labs.end(), labEntry) == first->labs.end())
+      {
+         for(auto &st : body)
+            if(std::find(st.labs.begin(), st.labs.end(), labEntry) != st.labs.end())
+               return;
+
+         first->labs += Core::Array<Core::String>{labEntry};
+      }
+
+      Core::FastU wb       = Target::GetWordBytes();
+      bool        autoProp = Target::IsCallAutoProp(func->ctype);
+      auto        origin   = body.getOrigin();
+
+      for(auto call : calls)
+      {
+         auto retn = GetTailRetn(*func, call, end);
+
+         Core::FastU words = 0, stkWords = 0;
+         for(std::size_t a = 2; a != call->args.size(); ++a)
+         {
+            words += GetArgWords(call->args[a]);
+            if(call->args[a].a == IR::ArgBase::Stk)
+               stkWords += GetArgWords(call->args[a]);
+         }
+
+         IR::Statement *pltn = nullptr;
+         if(autoProp && call->args[2].a == IR::ArgBase::Stk)
+            pltn = FindInlinePltn(body, call, stkWords - 1);
+
+         Core::Array<Core::String> labs;
+         if(pltn)
+         {
+            if(pltn->next == call)
+               labs = std::move(pltn->labs);
+            else if(!pltn->labs.empty())
+               pltn->next->labs += pltn->labs;
+            delete pltn;
+         }
+
+         body.setOrigin(call->pos);
+         body.addLabel(std::move(labs));
+
+         // Store arguments, last first. The stack pointer is unchanged.
+         for(std::size_t a = call->args.size(); a-- != 2;)
+         {
+            auto &arg = call->args[a];
+
+            words -= GetArgWords(arg);
+
+            if(autoProp && a == 2)
+            {
+               if(!pltn && arg.a == IR::ArgBase::Stk)
+                  body.addStmnt(call, IR::CodeBase::Move,
+                     IR::Arg_Nul(arg.getSize()), std::move(arg));
+               continue;
+            }
+
+            body.addStmnt(call, IR::CodeBase::Move,
+               IR::Arg_LocReg(arg.getSize(), IR::Arg_Lit(wb,
+                  IR::ExpCreate_Value(IR::Value_Fixed(
+                     Core::NumberCast<Core::Integ>(words * wb),
+                     IR::Type_Fixed{Target::GetWordBits(), 0, false, false}),
+                     call->pos))),
+               std::move(arg));
+         }
+
+         body.addStmnt(call, IR::CodeBase::Jump,
+            IR::Arg_Lit(wb, IR::ExpCreate_Glyph({prog, labEntry}, call->pos)));
+
+         // Remove the call, its far jump check, and an unshared return.
+         if(call->next != retn)
+            delete call->next;
+         if(retn->labs.empty())
+            delete retn;
+         delete call;
+      }
+
+      body.setOrigin(origin);
+   }
+
+   //
+   // Info::optInline
+   //
+   // Replaces calls to small functions that make no calls of their own
+   // with a copy of the function's body. Every expansion in a function
+   // shares the same added registers, since no two bodies are ever active
+   // at once.
+   //
+   void Info::optInline()
+   {
+      if(!OptInline)
+         return;
+
+      std::unordered_map<IR::Function const *, bool> inlineFunc;
+
+      // Returns the function called by st, if it can be inlined.
+      auto getCallee = [&](IR::Statement const &st) -> IR::Function *
+      {
+         if(st.code != IR::CodeBase::Call || st.args.size() < 2 ||
+            st.args[1].a != IR::ArgBase::Lit)
+            return nullptr;
+
+         auto exp = dynamic_cast<IR::Exp_Glyph const *>(&*st.args[1].aLit.value);
+         if(!exp)
+            return nullptr;
+
+         auto callee = prog->findFunction(exp->glyph);
+         if(!callee)
+            return nullptr;
+
+         auto itr = inlineFunc.find(callee);
+         if(itr == inlineFunc.end())
+            itr = inlineFunc.emplace(callee, IsInlineFunc(*callee)).first;
+
+         return itr->second ? callee : nullptr;
+      };
+
+      for(auto &fn : prog->rangeFunction())
+      {
+         if(!fn.defin)
+            continue;
+
+         Core::FastU reserve = GetLocRegReserve(fn);
+         Core::FastU base    = fn.localReg - reserve;
+         Core::FastU regTop  = 0;
+         bool        checked = !reserve;
+
+         for(auto st = fn.block.begin(), end = fn.block.end(); st != end;)
+         {
+            auto callee = getCallee(*st);
+            if(!callee || callee == &fn)
+            {
+               ++st;
+               continue;
+            }
+
+            // The stack pointer register must stay above the others.
+            if(!checked)
+            {
+               if(!IsInlineCaller(fn, base))
+                  break;
+
+               checked = true;
+            }
+
+            auto next = ExpandInline(*prog, fn, &*st, *callee, base);
+            if(!next)
+            {
+               ++st;
+               continue;
+            }
+
+            regTop = std::max(regTop, callee->localReg);
+            fn.setLocalTmp(callee->localTmp);
+
+            st = static_cast<IR::Block::iterator>(next);
+         }
+
+         if(regTop)
+            fn.localReg = base + regTop + reserve;
+      }
+   }
+}
+
+// EOF
+
@@ -0,0 +1,373 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2025 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Generic statement preparation.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Info.hpp"
+
+#include "Core/Option.hpp"
+
+#include "IR/Block.hpp"
+#include "IR/Exp.hpp"
+#include "IR/Statement.hpp"
+
+#include "Option/Bool.hpp"
+
+#include "Target/Info.hpp"
+
+#include <utility>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --bc-opt-strength
+   //
+   static Option::Bool OptStrength
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-opt-strength")
+         .setGroup("codegen")
+         .setDescS("Enables or disables literal arithmetic reduction.")
+         .setDescL(
+            "Enables or disables literal arithmetic reduction. When "
+            "enabled, multiplication, division, and modulo by literal "
+            "powers of two are replaced by shifts and masks.\n"
+            "\n"
+            "Default is on."),
+
+      true
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // GetLitArg
+   //
+   static IR::Arg_Lit GetLitArg(Core::FastU words, Core::Integ const &val,
+      Core::Origin pos)
+   {
+      IR::Type_Fixed type{words * Target::GetWordBits(), 0, false, false};
+
+      return {words * Target::GetWordBytes(),
+         IR::ExpCreate_Value(IR::Value_Fixed(val, type), pos)};
+   }
+
+   //
+   // GetLitWord
+   //
+   static IR::Arg_Lit GetLitWord(Core::FastU val, Core::Origin pos)
+   {
+      return GetLitArg(1, Core::NumberCast<Core::Integ>(val), pos);
+   }
+
+   //
+   // GetLitValue
+   //
+   // Gets the bits of a literal argument as an unsigned number.
+   //
+   static bool GetLitValue(IR::Arg const &arg, Core::FastU bits, Core::Integ &val)
+   {
+      if(arg.a != IR::ArgBase::Lit || arg.aLit.off || !arg.aLit.value->isValue())
+         return false;
+
+      auto v = arg.aLit.value->getValue();
+      if(v.v != IR::ValueBase::Fixed)
+         return false;
+
+      mpz_fdiv_r_2exp(val.get_mpz_t(), v.vFixed.value.get_mpz_t(), bits);
+      return true;
+   }
+
+   //
+   // GetLitPow2
+   //
+   // Gets the base 2 logarithm of a literal power of two.
+   //
+   static bool GetLitPow2(IR::Arg const &arg, Core::FastU bits, Core::FastU &log)
+   {
+      Core::Integ val;
+      if(!GetLitValue(arg, bits, val) || mpz_popcount(val.get_mpz_t()) != 1)
+         return false;
+
+      log = mpz_scan1(val.get_mpz_t(), 0);
+      return true;
+   }
+
+   //
+   // IsArgRepeat
+   //
+   // Returns true if arg can be read more than once.
+   //
+   static bool IsArgRepeat(IR::Arg const &arg)
+   {
+      switch(arg.a)
+      {
+      case IR::ArgBase::Lit:    return true;
+      case IR::ArgBase::LocReg: return arg.aLocReg.idx->a == IR::ArgBase::Lit;
+      default:                  return false;
+      }
+   }
+
+   //
+   // IsLitType
+   //
+   // Returns true for types whose multiplication and division by powers
+   // of two round the same as shifts.
+   //
+   static bool IsLitType(IR::CodeType type)
+   {
+      if(!OptStrength || type[1])
+         return false;
+
+      switch(type[0])
+      {
+      case 'I': case 'K': case 'U': case 'X': return true;
+      default:                                return false;
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // Info::preStmnt_Div_Lit
+   //
+   // Division by a literal power of two is a shift:
+   //    Div(Dst Src Lit(1 << K))
+   // Can be transformed into:
+   //    ShR+U(Dst Src Lit(K))
+   // Signed shifts round down, so negative dividends are biased first:
+   //    ShR+I(Stk N() Src Lit(B - 1))
+   //    ShR+U(Stk N() Stk N() Lit(B - K))
+   //    Add+U(Stk N() Stk N() Src)
+   //    ShR+I(Dst Stk N() Lit(K))
+   //
+   // If the statement is replaced, preparation restarts at the new code.
+   //
+   void Info::preStmnt_Div_Lit()
+   {
+      if(!IsLitType(stmnt->code.type))
+         return;
+
+      auto        pos  = stmnt->pos;
+      auto        size = stmnt->args[0].getSize();
+      Core::FastU n    = size / Target::GetWordBytes();
+      Core::FastU bits = n * Target::GetWordBits();
+
+      if(!n || stmnt->args[2].getSize() != size)
+         return;
+
+      FixedInfo   fi = getFixedInfo(n, stmnt->code.type[0]);
+      Core::FastU log;
+
+      if(!GetLitPow2(stmnt->args[2], bits, log))
+         return;
+
+      // A signed literal with only the sign bit set is negative.
+      if(fi.bitsS && log == bits - 1)
+         return;
+
+      // Fixed-point quotients are shifted left by the fractional bits.
+      if(log <= fi.bitsF)
+      {
+         if(log == fi.bitsF)
+         {
+            stmnt->code = IR::CodeBase::Move;
+            stmnt->args = {stmnt->args[0], stmnt->args[1]};
+         }
+         else
+         {
+            stmnt->code    = IR::CodeBase::ShL+'U';
+            stmnt->args[2] = GetLitWord(fi.bitsF - log, pos);
+         }
+
+         throw ResetStmnt();
+      }
+
+      log -= fi.bitsF;
+
+      if(!fi.bitsS)
+      {
+         stmnt->code    = IR::CodeBase::ShR+'U';
+         stmnt->args[2] = GetLitWord(log, pos);
+
+         throw ResetStmnt();
+      }
+
+      // Single word signed division is native.
+      if(n == 1 || !IsArgRepeat(stmnt->args[1]))
+         return;
+
+      IR::Arg_Stk stk{size};
+      auto const &src   = stmnt->args[1];
+      auto        first = stmnt->prev;
+
+      block->setOrigin(pos);
+      block->addLabel(std::move(stmnt->labs));
+      block->addStmnt(stmnt, IR::CodeBase::ShR+'I', stk, src, GetLitWord(bits - 1, pos));
+      block->addStmnt(stmnt, IR::CodeBase::ShR+'U', stk, stk, GetLitWord(bits - log, pos));
+      block->addStmnt(stmnt, IR::CodeBase::Add+'U', stk, stk, src);
+      block->addStmnt(stmnt, IR::CodeBase::ShR+'I', stmnt->args[0], stk, GetLitWord(log, pos));
+
+      delete stmnt;
+      stmnt = first->next;
+
+      throw ResetStmnt();
+   }
+
+   //
+   // Info::preStmnt_Mod_Lit
+   //
+   // Unsigned modulo by a literal power of two is a mask:
+   //    Mod+U(Dst Src Lit(1 << K))
+   // Can be transformed into:
+   //    BAnd(Dst Src Lit((1 << K) - 1))
+   // Multi-word signed modulo subtracts the rounded down dividend:
+   //    Move(Stk N() Src)
+   //    ShR+I(Stk N() Src Lit(B - 1))
+   //    ShR+U(Stk N() Stk N() Lit(B - K))
+   //    Add+U(Stk N() Stk N() Src)
+   //    BAnd(Stk N() Stk N() Lit(-(1 << K)))
+   //    Sub+U(Dst Stk N() Stk N())
+   //
+   // If the statement is replaced, preparation restarts at the new code.
+   //
+   void Info::preStmnt_Mod_Lit()
+   {
+      if(!IsLitType(stmnt->code.type))
+         return;
+
+      auto        pos  = stmnt->pos;
+      auto        size = stmnt->args[0].getSize();
+      Core::FastU n    = size / Target::GetWordBytes();
+      Core::FastU bits = n * Target::GetWordBits();
+
+      if(!n || stmnt->args[2].getSize() != size)
+         return;
+
+      FixedInfo   fi = getFixedInfo(n, stmnt->code.type[0]);
+      Core::FastU log;
+
+      if(!GetLitPow2(stmnt->args[2], bits, log))
+         return;
+
+      if(!fi.bitsS || log == 0)
+      {
+         stmnt->code    = IR::CodeBase::BAnd;
+         stmnt->args[2] = GetLitArg(n, (Core::Integ(1) << log) - 1, pos);
+
+         throw ResetStmnt();
+      }
+
+      // Single word signed modulo is native.
+      if(log == bits - 1 || n == 1 || !IsArgRepeat(stmnt->args[1]))
+         return;
+
+      Core::Integ mask = (Core::Integ(1) << bits) - (Core::Integ(1) << log);
+
+      IR::Arg_Stk stk{size};
+      auto const &src   = stmnt->args[1];
+      auto        first = stmnt->prev;
+
+      block->setOrigin(pos);
+      block->addLabel(std::move(stmnt->labs));
+      block->addStmnt(stmnt, IR::CodeBase::Move, stk, src);
+      block->addStmnt(stmnt, IR::CodeBase::ShR+'I', stk, src, GetLitWord(bits - 1, pos));
+      block->addStmnt(stmnt, IR::CodeBase::ShR+'U', stk, stk, GetLitWord(bits - log, pos));
+      block->addStmnt(stmnt, IR::CodeBase::Add+'U', stk, stk, src);
+      block->addStmnt(stmnt, IR::CodeBase::BAnd, stk, stk, GetLitArg(n, mask, pos));
+      block->addStmnt(stmnt, IR::CodeBase::Sub+'U', stmnt->args[0], stk, stk);
+
+      delete stmnt;
+      stmnt = first->next;
+
+      throw ResetStmnt();
+   }
+
+   //
+   // Info::preStmnt_Mul_Lit
+   //
+   // Multiplication by a literal power of two is a shift:
+   //    Mul(Dst Src Lit(1 << K))
+   // Can be transformed into:
+   //    ShL+U(Dst Src Lit(K))
+   // Fixed-point products are shifted right by the fractional bits.
+   //
+   // If the statement is replaced, preparation restarts at the new code.
+   //
+   void Info::preStmnt_Mul_Lit()
+   {
+      if(!IsLitType(stmnt->code.type))
+         return;
+
+      auto        pos  = stmnt->pos;
+      auto        size = stmnt->args[0].getSize();
+      Core::FastU n    = size / Target::GetWordBytes();
+      Core::FastU bits = n * Target::GetWordBits();
+
+      if(!n || stmnt->args[1].getSize() != size || stmnt->args[2].getSize() != size)
+         return;
+
+      FixedInfo   fi = getFixedInfo(n, stmnt->code.type[0]);
+      Core::FastU log;
+      std::size_t src;
+
+      if(GetLitPow2(stmnt->args[2], bits, log))
+         src = 1;
+      else if(GetLitPow2(stmnt->args[1], bits, log))
+         src = 2;
+      else
+         return;
+
+      // A signed literal with only the sign bit set is negative.
+      if(fi.bitsS && log == bits - 1)
+         return;
+
+      if(src == 2)
+         std::swap(stmnt->args[1], stmnt->args[2]);
+
+      if(log == fi.bitsF)
+      {
+         stmnt->code = IR::CodeBase::Move;
+         stmnt->args = {stmnt->args[0], stmnt->args[1]};
+      }
+      else if(log > fi.bitsF)
+      {
+         stmnt->code    = IR::CodeBase::ShL+'U';
+         stmnt->args[2] = GetLitWord(log - fi.bitsF, pos);
+      }
+      else
+      {
+         stmnt->code    = IR::CodeBase::ShR+(fi.bitsS ? 'I' : 'U');
+         stmnt->args[2] = GetLitWord(fi.bitsF - log, pos);
+      }
+
+      throw ResetStmnt();
+   }
+}
+
+// EOF
+
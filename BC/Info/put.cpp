@@ -12,6 +12,9 @@
 
 #include "BC/Info.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -19,13 +22,49 @@
 
 namespace GDCC::BC
 {
+   //
+   // Info::putAlloc
+   //
+   // Returns storage for the next size bytes of output.
+   //
+   char *Info::putAlloc(std::size_t size)
+   {
+      if(putBufSize - putPos < size)
+         putReserve(std::max(putPos + size, putBufSize * 2));
+
+      char *data = putBuf.get() + putPos;
+      putPos += size;
+      return data;
+   }
+
    //
    // putData
    //
    void Info::putData(char const *data, std::size_t size)
    {
-      out->write(data, size);
-      putPos += size;
+      // memcpy requires valid pointers even for no bytes, and the buffer may
+      // not be allocated yet.
+      if(!size) return;
+
+      std::memcpy(putAlloc(size), data, size);
+   }
+
+   //
+   // Info::putReserve
+   //
+   // Ensures the output buffer can hold size bytes in total.
+   //
+   void Info::putReserve(std::size_t size)
+   {
+      if(size <= putBufSize)
+         return;
+
+      std::unique_ptr<char[]> buf{new char[size]};
+      if(putPos)
+         std::memcpy(buf.get(), putBuf.get(), putPos);
+
+      putBuf     = std::move(buf);
+      putBufSize = size;
    }
 }
 
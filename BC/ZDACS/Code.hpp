@@ -63,6 +63,15 @@ namespace GDCC::BC::ZDACS
       SubU_LocReg =  34,
       SubU_ModReg =  35,
       SubU_HubReg =  36,
+      MulU_LocReg =  37,
+      MulU_ModReg =  38,
+      MulU_HubReg =  39,
+      DivI_LocReg =  40,
+      DivI_ModReg =  41,
+      DivI_HubReg =  42,
+      ModI_LocReg =  43,
+      ModI_ModReg =  44,
+      ModI_HubReg =  45,
       IncU_LocReg =  46,
       IncU_ModReg =  47,
       IncU_HubReg =  48,
@@ -86,10 +95,14 @@ namespace GDCC::BC::ZDACS
       Jcnd_Lit    =  84,
       MulX        = 136,
       DivX        = 137,
+      Push_LitB   = 167,
       Drop_GblReg = 181,
       Push_GblReg = 182,
       AddU_GblReg = 183,
       SubU_GblReg = 184,
+      MulU_GblReg = 185,
+      DivI_GblReg = 186,
+      ModI_GblReg = 187,
       IncU_GblReg = 188,
       DecU_GblReg = 189,
       Call_Lit    = 203,
@@ -114,6 +127,26 @@ namespace GDCC::BC::ZDACS
       Jcnd_Tab    = 256,
       Drop_ScrRet = 257,
       Cspe_5R1    = 263,
+      BAnd_LocReg = 291,
+      BAnd_ModReg = 292,
+      BAnd_HubReg = 293,
+      BAnd_GblReg = 294,
+      BOrX_LocReg = 298,
+      BOrX_ModReg = 299,
+      BOrX_HubReg = 300,
+      BOrX_GblReg = 301,
+      BOrI_LocReg = 305,
+      BOrI_ModReg = 306,
+      BOrI_HubReg = 307,
+      BOrI_GblReg = 308,
+      ShLU_LocReg = 312,
+      ShLU_ModReg = 313,
+      ShLU_HubReg = 314,
+      ShLU_GblReg = 315,
+      ShRI_LocReg = 319,
+      ShRI_ModReg = 320,
+      ShRI_HubReg = 321,
+      ShRI_GblReg = 322,
       BNot        = 330,
       Cnat        = 351,
       Pfun_Lit    = 359,
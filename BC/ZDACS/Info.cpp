@@ -61,6 +61,24 @@ namespace GDCC::BC::ZDACS
       false
    };
 
+   //
+   // --bc-zdacs-compressed
+   //
+   Option::Bool Info::UseCompressed
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-zdacs-compressed")
+         .setGroup("output")
+         .setDescS("Generates compressed ACSe bytecode.")
+         .setDescL(
+            "Generates compressed ACSe bytecode, which uses byte opcodes "
+            "and byte arguments where possible. Variable, array, and "
+            "function indexes must then fit in a byte. Has no effect for "
+            "ACS0 output."),
+
+      false
+   };
+
    //
    // --bc-zdacs-fake-ACS0
    //
@@ -74,6 +92,24 @@ namespace GDCC::BC::ZDACS
       false
    };
 
+   //
+   // --bc-zdacs-init-compact
+   //
+   Option::Bool Info::InitCompact
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-zdacs-init-compact")
+         .setGroup("codegen")
+         .setDescS("Uses loops to initialize long runs of array data.")
+         .setDescL(
+            "Uses loops to initialize long runs of array data. Repeated "
+            "values and patterns are written by a loop, and other runs are "
+            "copied from a module array instead of being set one word at a "
+            "time. On by default."),
+
+      true
+   };
+
    //
    // --bc-zdacs-init-delay
    //
@@ -218,6 +254,37 @@ namespace GDCC::BC::ZDACS
       999
    };
 
+   //
+   // --bc-zdacs-peephole
+   //
+   Option::Bool Info::UsePeephole
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-zdacs-peephole")
+         .setGroup("codegen")
+         .setDescS("Rewrites generated code sequences into cheaper ones.")
+         .setDescL(
+            "Rewrites generated code sequences into cheaper ones. For "
+            "example, a store to a variable followed by a load of it "
+            "becomes a Copy and a store, and jumps to jumps go directly to "
+            "the final target. On by default."),
+
+      true
+   };
+
+   //
+   // --bc-zdacs-peephole-stats
+   //
+   Option::Bool Info::PeepholeStats
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-zdacs-peephole-stats")
+         .setGroup("debugging")
+         .setDescS("Prints how often each peephole rule applied."),
+
+      false
+   };
+
    //
    // --bc-zdacs-script-flag
    //
@@ -322,7 +389,9 @@ namespace GDCC::BC::ZDACS
    //
    // Info default constructor
    //
-   Info::Info()
+   Info::Info() :
+      initCopyArr{0},
+      moduleCodeFence{0}
    {
    }
 
@@ -557,8 +626,12 @@ namespace GDCC::BC::ZDACS
    //
    // Info::getCodePos
    //
+   // Anything that takes the current position might jump to it, so codes
+   // already generated are no longer open to peephole rewriting.
+   //
    Core::FastU Info::getCodePos()
    {
+      moduleCodeFence = module->chunkCODE.size();
       return CodeBase() + module->chunkCODE.getPos();
    }
 
@@ -667,6 +740,16 @@ namespace GDCC::BC::ZDACS
       return w ? IR::TypeBase::Fixed : IR::TypeBase::StrEn;
    }
 
+   //
+   // Info::isByteArg
+   //
+   // Returns true if arg is already known to fit in a byte.
+   //
+   bool Info::isByteArg(ElemArg const &arg)
+   {
+      return (!arg.exp || arg.exp->isValue()) && getWord(arg) < 0x100;
+   }
+
    //
    // Info::isDecUArg
    //
@@ -888,6 +971,134 @@ namespace GDCC::BC::ZDACS
          return 24;
    }
 
+   //
+   // Info::GetCodeArgSize
+   //
+   // Returns the encoded size of an instruction argument. Arguments not
+   // listed here are always a full word, including those of the direct
+   // codes used by asm functions.
+   //
+   Core::FastU Info::GetCodeArgSize(Code code, std::size_t i)
+   {
+      if(!IsCompressed())
+         return 4;
+
+      switch(code)
+      {
+      case Code::AddU_GblReg:
+      case Code::AddU_HubReg:
+      case Code::AddU_LocReg:
+      case Code::AddU_ModReg:
+      case Code::BAnd_GblReg:
+      case Code::BAnd_HubReg:
+      case Code::BAnd_LocReg:
+      case Code::BAnd_ModReg:
+      case Code::BOrI_GblReg:
+      case Code::BOrI_HubReg:
+      case Code::BOrI_LocReg:
+      case Code::BOrI_ModReg:
+      case Code::BOrX_GblReg:
+      case Code::BOrX_HubReg:
+      case Code::BOrX_LocReg:
+      case Code::BOrX_ModReg:
+      case Code::Call_Lit:
+      case Code::Call_Nul:
+      case Code::Cspe_1:
+      case Code::Cspe_2:
+      case Code::Cspe_3:
+      case Code::Cspe_4:
+      case Code::Cspe_5:
+      case Code::Cspe_5R1:
+      case Code::DecU_GblArr:
+      case Code::DecU_GblReg:
+      case Code::DecU_HubArr:
+      case Code::DecU_HubReg:
+      case Code::DecU_LocArr:
+      case Code::DecU_LocReg:
+      case Code::DecU_ModArr:
+      case Code::DecU_ModReg:
+      case Code::DivI_GblReg:
+      case Code::DivI_HubReg:
+      case Code::DivI_LocReg:
+      case Code::DivI_ModReg:
+      case Code::Drop_GblArr:
+      case Code::Drop_GblReg:
+      case Code::Drop_HubArr:
+      case Code::Drop_HubReg:
+      case Code::Drop_LocArr:
+      case Code::Drop_LocReg:
+      case Code::Drop_ModArr:
+      case Code::Drop_ModReg:
+      case Code::IncU_GblArr:
+      case Code::IncU_GblReg:
+      case Code::IncU_HubArr:
+      case Code::IncU_HubReg:
+      case Code::IncU_LocArr:
+      case Code::IncU_LocReg:
+      case Code::IncU_ModArr:
+      case Code::IncU_ModReg:
+      case Code::ModI_GblReg:
+      case Code::ModI_HubReg:
+      case Code::ModI_LocReg:
+      case Code::ModI_ModReg:
+      case Code::MulU_GblReg:
+      case Code::MulU_HubReg:
+      case Code::MulU_LocReg:
+      case Code::MulU_ModReg:
+      case Code::Pfun_Lit:
+      case Code::Push_GblArr:
+      case Code::Push_GblReg:
+      case Code::Push_HubArr:
+      case Code::Push_HubReg:
+      case Code::Push_LitB:
+      case Code::Push_LocArr:
+      case Code::Push_LocReg:
+      case Code::Push_ModArr:
+      case Code::Push_ModReg:
+      case Code::ShLU_GblReg:
+      case Code::ShLU_HubReg:
+      case Code::ShLU_LocReg:
+      case Code::ShLU_ModReg:
+      case Code::ShRI_GblReg:
+      case Code::ShRI_HubReg:
+      case Code::ShRI_LocReg:
+      case Code::ShRI_ModReg:
+      case Code::SubU_GblReg:
+      case Code::SubU_HubReg:
+      case Code::SubU_LocReg:
+      case Code::SubU_ModReg:
+         return 1;
+
+      // Special number is a byte, but the direct arguments are words.
+      case Code::Cspe_1L:
+      case Code::Cspe_2L:
+      case Code::Cspe_3L:
+      case Code::Cspe_4L:
+      case Code::Cspe_5L:
+         return i == 0 ? 1 : 4;
+
+      // Argument count is a byte and function index is a half-word.
+      case Code::Cnat:
+         return i == 0 ? 1 : 2;
+
+      default:
+         return 4;
+      }
+   }
+
+   //
+   // Info::GetCodeSize
+   //
+   // Returns the encoded size of an opcode.
+   //
+   Core::FastU Info::GetCodeSize(Code code)
+   {
+      if(!IsCompressed())
+         return 4;
+
+      return static_cast<Core::FastU>(code) < 240 ? 1 : 2;
+   }
+
    //
    // Info:GetParamMax
    //
@@ -1009,6 +1220,14 @@ namespace GDCC::BC::ZDACS
          return script->valueInt;
    }
 
+   //
+   // Info::IsCompressed
+   //
+   bool Info::IsCompressed()
+   {
+      return UseCompressed && Target::FormatCur != Target::Format::ACS0;
+   }
+
    //
    // Info::IsNull
    //
@@ -23,6 +23,7 @@
 #include "../../Core/Counter.hpp"
 #include "../../Core/Number.hpp"
 #include "../../Core/NumberAlloc.hpp"
+#include "../../Core/StringGen.hpp"
 #include "../../Core/StringOption.hpp"
 
 #include "../../IR/Code.hpp"
@@ -33,7 +34,10 @@
 #include "../../Target/Addr.hpp"
 #include "../../Target/CallType.hpp"
 
+#include <map>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 
 //----------------------------------------------------------------------------|
@@ -59,6 +63,7 @@ namespace GDCC::BC::ZDACS
 
       static Core::FastU FarJumpIndex;
 
+      static Option::Bool             InitCompact;
       static Option::Bool             InitDelay;
       static Core::StringOption       InitScriptName;
       static Option::Bool             InitScriptNamed;
@@ -67,10 +72,14 @@ namespace GDCC::BC::ZDACS
       static ScriptTypeMap ScriptFlags;
       static ScriptTypeMap ScriptTypes;
 
+      static Option::Bool PeepholeStats;
+
       static Option::Int<Core::FastU> StaArray;
 
       static Option::Bool UseChunkSTRE;
+      static Option::Bool UseCompressed;
       static Option::Bool UseFakeACS0;
+      static Option::Bool UsePeephole;
 
    protected:
       //
@@ -181,10 +190,26 @@ namespace GDCC::BC::ZDACS
       virtual void genFunc();
 
       void genIniti();
+      void genInitiLoop(Core::FastU arr, Code code, Core::FastU idx,
+         Core::FastU size, Core::FastU period, Core::FastU const *data);
       void genInitiSpace(IR::Space &space, Code code);
+      void genInitiWords(Core::FastU arr, Code code, Core::FastU idx,
+         std::vector<Core::FastU> const &data);
 
       virtual void genObj();
 
+      void genPeep();
+      bool genPeep_Comp();
+      bool genPeep_DropPush();
+      bool genPeep_FoldBin();
+      bool genPeep_FoldUna();
+      bool genPeep_IncDec();
+      bool genPeep_PushDrop();
+      bool genPeepArg(ElemArg const &l, ElemArg const &r);
+      void genPeepHit(char const *rule);
+      void genPeepJump();
+      bool genPeepLit(ElemCODE const &code, Core::FastU &val);
+
       virtual void genSpace();
       void genSpaceIniti();
       void genSpaceIniti(IR::Space &space);
@@ -384,6 +409,8 @@ namespace GDCC::BC::ZDACS
       virtual IR::TypeBase getWordType_Funct(IR::Type_Funct const &type, Core::FastU w);
       virtual IR::TypeBase getWordType_StrEn(IR::Type_StrEn const &type, Core::FastU w);
 
+      bool isByteArg(ElemArg const &arg);
+
       bool isCopyArg(IR::Arg const &arg);
 
       bool isDecUArg(IR::Arg const &arg);
@@ -432,6 +459,9 @@ namespace GDCC::BC::ZDACS
 
       std::size_t lenString(Core::String str);
 
+      virtual std::unique_ptr<InfoBase> newInfo() const
+         {return std::unique_ptr<InfoBase>{new Info};}
+
       virtual void preFunc();
 
       virtual void preObj();
@@ -560,6 +590,8 @@ namespace GDCC::BC::ZDACS
       void putChunkSVCT();
 
       void putCode();
+      void putCodeArg(ElemArg const &arg, Core::FastU size);
+      void putCodeOp(Core::FastU code);
 
       void putHWord(Core::FastU i);
 
@@ -661,13 +693,26 @@ namespace GDCC::BC::ZDACS
 
       std::unordered_map<IR::Space const *, InitData> init;
 
+      // Words copied by init script loops, stored in an AINI module array.
+      std::vector<Core::FastU> initCopy;
+      Core::FastU              initCopyArr;
+      Core::StringGen          initLoopGen;
+
       std::unique_ptr<Module> module;
 
+      // Codes before this index may be jumped to and must not be rewritten.
+      std::size_t moduleCodeFence;
+
+      std::map<std::string, Core::FastU> peepHits;
+
       std::unordered_map<IR::Space const *, bool> spaceUsed;
 
 
       static Core::FastU CodeBase();
 
+      static Core::FastU GetCodeArgSize(Code code, std::size_t i);
+      static Core::FastU GetCodeSize(Code code);
+
       static Core::FastU GetParamMax(IR::CallType call);
 
       static Core::FastU GetRetnMax(IR::CallType call);
@@ -676,6 +721,8 @@ namespace GDCC::BC::ZDACS
       static Core::FastU GetScriptType(IR::Function const *script);
       static Core::FastU GetScriptValue(IR::Function const *script);
 
+      static bool IsCompressed();
+
       static bool IsNull(IR::Value_Funct const &val);
       static bool IsNull(IR::Value_StrEn const &val);
 
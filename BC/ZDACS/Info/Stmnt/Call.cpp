@@ -442,7 +442,7 @@ namespace GDCC::BC::ZDACS
       if(func->allocAut)
       {
          genCode(Code::Push_LocReg, getStkPtrIdx());
-         genCode(Code::Call_Nul,    "___GDCC__Plsf");
+         genCode(Code::Call_Nul,    FuncFreeAut);
       }
 
       switch(func->ctype)
@@ -506,7 +506,7 @@ namespace GDCC::BC::ZDACS
       if(func->allocAut)
       {
          genCode(Code::Push_LocReg, getStkPtrIdx());
-         genCode(Code::Call_Nul,    "___GDCC__Plsf");
+         genCode(Code::Call_Nul,    FuncFreeAut);
       }
 
       switch(func->ctype)
@@ -550,7 +550,7 @@ namespace GDCC::BC::ZDACS
    void Info::preStmnt_Retn()
    {
       if(func->allocAut)
-         preStmntCall("___GDCC__Plsf", 0, 1);
+         preStmntCall(FuncFreeAut, 0, 1);
    }
 
    //
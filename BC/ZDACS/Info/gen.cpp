@@ -20,6 +20,8 @@
 
 #include "Target/CallType.hpp"
 
+#include <iostream>
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -33,6 +35,8 @@ namespace GDCC::BC::ZDACS
    void Info::gen()
    {
       module.reset(new Module);
+      moduleCodeFence = 0;
+      peepHits.clear();
 
       prog->genObjectBySpace();
 
@@ -46,6 +50,17 @@ namespace GDCC::BC::ZDACS
          func = nullptr;
       }
 
+      // Allocate function indexes before generating codes, so that calls
+      // can tell whether the index fits in a byte.
+      for(auto &fn : prog->rangeFunction())
+      {
+         if(!fn.alloc) continue;
+         if(fn.ctype != IR::CallType::StdCall && fn.ctype != IR::CallType::StkCall) continue;
+
+         fn.allocValue(getAllocFunc(fn.ctype));
+         backGlyphFunc(fn.glyph, fn.valueInt, fn.ctype);
+      }
+
       InfoBase::gen();
 
       for(auto const &import : prog->rangeImport())
@@ -60,6 +75,15 @@ namespace GDCC::BC::ZDACS
 
       genIniti();
 
+      if(UsePeephole)
+         genPeepJump();
+
+      if(PeepholeStats)
+      {
+         for(auto const &hit : peepHits)
+            std::cerr << "peephole " << hit.first << ": " << hit.second << '\n';
+      }
+
       // TODO 2024-12-31: ACS0 constraint checks.
    }
 
@@ -164,20 +188,64 @@ namespace GDCC::BC::ZDACS
    //
    void Info::genCode(Code code, ElemArgs &&args)
    {
+      if(IsCompressed()) switch(code)
+      {
+         // Use the byte form of literal pushes where the value is known.
+      case Code::Push_Lit:
+         if(args.size() == 1 && isByteArg(args[0]))
+            code = Code::Push_LitB;
+         break;
+
+         // Function indexes are a byte in compressed ACSe. Otherwise, the
+         // index is pushed and called or combined with the module's tag.
+         // Call_Stk always pushes a result, even for void functions.
+      case Code::Call_Lit:
+      case Code::Call_Nul:
+         if(isByteArg(args[0]))
+            break;
+
+         genCode(Code::Push_Lit, args[0]);
+         genCode(Code::Call_Stk);
+         if(code == Code::Call_Nul)
+            genCode(Code::Drop_Nul);
+         return;
+
+      case Code::Pfun_Lit:
+         if(isByteArg(args[0]))
+            break;
+
+         genCode(Code::Pfun_Lit, 0);
+         genCode(Code::Push_Lit, args[0]);
+         genCode(Code::BOrI);
+         return;
+
+      default:
+         break;
+      }
+
       Core::FastU cpos = module->chunkCODE.getPos();
-      Core::FastU size = 4;
+
+      Core::FastU size = GetCodeSize(code);
 
       switch(code)
       {
-         // TODO 2024-12-30: Add padding to Jcnd_Lit for word alignment before
-         //    implementing any codes with sub-word arguments. (Or ACSe.)
+      case Code::Jcnd_Tab:
+         // Case table must be word-aligned.
+         if(IsCompressed())
+            size += -(CodeBase() + cpos + size) & 3;
+         size += args.size() * 4;
+         break;
 
       default:
-         size += args.size() * 4;
+         for(std::size_t i = 0, e = args.size(); i != e; ++i)
+            size += GetCodeArgSize(code, i);
          break;
       }
 
       module->chunkCODE.add(cpos, size, static_cast<Core::FastU>(code), std::move(args));
+
+      if(UsePeephole)
+         genPeep();
    }
 
    //
@@ -216,7 +284,7 @@ namespace GDCC::BC::ZDACS
       if(func->defin && func->allocAut)
       {
          genCode(Code::Push_Lit,    func->allocAut);
-         genCode(Code::Call_Lit,    "___GDCC__Plsa");
+         genCode(Code::Call_Lit,    FuncAllocAut);
          genCode(Code::Drop_LocReg, getStkPtrIdx());
       }
 
@@ -1,6 +1,6 @@
 //-----------------------------------------------------------------------------
 //
-// Copyright (C) 2014-2019 David Hill
+// Copyright (C) 2014-2025 David Hill
 //
 // See COPYING for license information.
 //
@@ -20,9 +20,60 @@
 
 #include "Target/Info.hpp"
 
+#include <algorithm>
 #include <sstream>
 
 
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::BC::ZDACS
+{
+   // Shortest run of words to initialize with a loop.
+   static constexpr Core::FastU InitiRunMin = 8;
+
+   // Longest repeated pattern to look for.
+   static constexpr Core::FastU InitiPeriodMax = 16;
+
+   // Most zero words allowed between the words of a run.
+   static constexpr Core::FastU InitiGapMax = 4;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC::ZDACS
+{
+   //
+   // GetInitiPeriod
+   //
+   // Finds the repeated pattern that covers the most words starting at
+   // data[i]. Returns the number of words covered and sets period to the
+   // length of the pattern.
+   //
+   static Core::FastU GetInitiPeriod(std::vector<Core::FastU> const &data,
+      Core::FastU i, Core::FastU &period)
+   {
+      Core::FastU best = 0;
+
+      for(Core::FastU k = 1; k <= InitiPeriodMax && i + k <= data.size(); ++k)
+      {
+         Core::FastU j = i + k;
+         while(j != data.size() && data[j] == data[j - k]) ++j;
+
+         // The pattern must occur at least twice.
+         if(j - i > best && j - i >= k * 2)
+            best = j - i, period = k;
+      }
+
+      return best;
+   }
+}
+
+
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
 //
@@ -56,6 +107,9 @@ namespace GDCC::BC::ZDACS
       Core::String label = InitScriptName;
       Core::String labelEnd = label + "$end";
 
+      initCopy.clear();
+      initLoopGen.reset(label, "$loop");
+
       // Add script table entries.
       {
          Core::FastU entry = getCodePos();
@@ -126,6 +180,17 @@ namespace GDCC::BC::ZDACS
          genInitiSpace(prog->getSpaceSta(), Code::Drop_GblArr);
       }
 
+      // Add copied words to the module.
+      if(!initCopy.empty())
+      {
+         ElemArgs inits{initCopy.size()};
+         for(std::size_t i = 0, e = initCopy.size(); i != e; ++i)
+            inits[i].val = initCopy[i];
+
+         module->chunkARAY.add(initCopyArr, initCopy.size());
+         module->chunkAINI.add(initCopyArr, std::move(inits));
+      }
+
       // Set initialized flag(s) after a delay to allow other
       // initialization scripts to run on first tic.
       if(InitDelay)
@@ -151,6 +216,70 @@ namespace GDCC::BC::ZDACS
       genCode(Code::Rscr);
    }
 
+   //
+   // Info::genInitiLoop
+   //
+   // Writes size words starting at idx by repeating the first period words
+   // of data. LocReg 1 counts down the words left to write. Unless the words
+   // are all the same, they are read from the copy array.
+   //
+   void Info::genInitiLoop(Core::FastU arr, Code code, Core::FastU idx,
+      Core::FastU size, Core::FastU period, Core::FastU const *data)
+   {
+      Core::FastU off = 0;
+
+      if(period != 1)
+      {
+         if(initCopy.empty())
+         {
+            initCopyArr = getAllocSpace(IR::AddrBase::ModArr).alloc(1);
+            getAllocObj({IR::AddrBase::ModReg, Core::STR_}).allocAt(1, initCopyArr);
+         }
+
+         off = initCopy.size();
+         initCopy.insert(initCopy.end(), data, data + period);
+      }
+
+      Core::String labelLoop = initLoopGen();
+
+      genCode(Code::Push_Lit,    size);
+      genCode(Code::Drop_LocReg, 1);
+      backGlyphLabel(labelLoop);
+      genCode(Code::DecU_LocReg, 1);
+
+      // Push index.
+      genCode(Code::Push_LocReg, 1);
+      if(idx)
+      {
+         genCode(Code::Push_Lit, idx);
+         genCode(Code::AddU);
+      }
+
+      // Push value.
+      if(period == 1)
+         genCode(Code::Push_Lit, data[0]);
+      else
+      {
+         genCode(Code::Push_LocReg, 1);
+         if(period != size)
+         {
+            genCode(Code::Push_Lit, period);
+            genCode(Code::ModI);
+         }
+         if(off)
+         {
+            genCode(Code::Push_Lit, off);
+            genCode(Code::AddU);
+         }
+         genCode(Code::Push_ModArr, initCopyArr);
+      }
+
+      genCode(code, arr);
+
+      genCode(Code::Push_LocReg, 1);
+      genCode(Code::Jcnd_Tru,    labelLoop);
+   }
+
    //
    // Info::genInitiSpace
    //
@@ -158,8 +287,23 @@ namespace GDCC::BC::ZDACS
    {
       auto const &ini = init[&space_];
 
+      // Sort initializers so that runs of words can be found.
+      std::vector<std::pair<Core::FastU, InitVal>> vals{ini.vals.begin(), ini.vals.end()};
+      std::sort(vals.begin(), vals.end(),
+         [](auto const &l, auto const &r) {return l.first < r.first;});
+
+      // Current run of words.
+      std::vector<Core::FastU> data;
+      Core::FastU              base = 0;
+
+      auto genData = [&]()
+      {
+         genInitiWords(space_.value, code, base, data);
+         data.clear();
+      };
+
       // Write instructions needed for initializers.
-      for(auto const &val : ini.vals) switch(val.second.tag)
+      for(auto const &val : vals) switch(val.second.tag)
       {
       case InitTag::Empty: break;
 
@@ -167,23 +311,80 @@ namespace GDCC::BC::ZDACS
          // Skip zeroes.
          if(!val.second.val) break;
 
-         genCode(Code::Push_Lit, val.first);
-         genCode(Code::Push_Lit, val.second.val);
-         genCode(code, space_.value);
+         if(!data.empty() && val.first - (base + data.size()) > InitiGapMax)
+            genData();
+
+         if(data.empty())
+            base = val.first;
+
+         data.resize(val.first - base, 0);
+         data.push_back(val.second.val);
          break;
 
       case InitTag::Funct:
+         genData();
          genCode(Code::Push_Lit, val.first);
          genStmntPushFunct(val.second.val);
          genCode(code, space_.value);
          break;
 
       case InitTag::StrEn:
+         genData();
          genCode(Code::Push_Lit, val.first);
          genStmntPushStrEn(val.second.val);
          genCode(code, space_.value);
          break;
       }
+
+      genData();
+   }
+
+   //
+   // Info::genInitiWords
+   //
+   // Writes data starting at idx. Repeated words and patterns are
+   // written by loops, as are other long runs if they can be copied from a
+   // module array. Anything else is written one word at a time.
+   //
+   void Info::genInitiWords(Core::FastU arr, Code code, Core::FastU idx,
+      std::vector<Core::FastU> const &data)
+   {
+      // ACS0 has no module arrays to copy from.
+      bool copy = InitCompact && Target::FormatCur != Target::Format::ACS0;
+
+      auto genWords = [&](Core::FastU i, Core::FastU e)
+      {
+         if(copy && e - i >= InitiRunMin)
+            return genInitiLoop(arr, code, idx + i, e - i, e - i, &data[i]);
+
+         for(; i != e; ++i)
+         {
+            // Skip zeroes.
+            if(!data[i]) continue;
+
+            genCode(Code::Push_Lit, idx + i);
+            genCode(Code::Push_Lit, data[i]);
+            genCode(code, arr);
+         }
+      };
+
+      Core::FastU i = 0, lit = 0;
+      while(InitCompact && i != data.size())
+      {
+         Core::FastU period = 0;
+         Core::FastU size   = GetInitiPeriod(data, i, period);
+
+         if(size >= InitiRunMin && (period == 1 || copy))
+         {
+            genWords(lit, i);
+            genInitiLoop(arr, code, idx + i, size, period, &data[i]);
+            lit = i += size;
+         }
+         else
+            ++i;
+      }
+
+      genWords(lit, data.size());
    }
 }
 
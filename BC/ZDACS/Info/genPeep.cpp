@@ -0,0 +1,551 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2025 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// ZDoom ACS peephole optimization.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/ZDACS/Info.hpp"
+
+#include "BC/ZDACS/Module.hpp"
+
+#include "IR/Exp.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::BC::ZDACS
+{
+   //
+   // PeepReg
+   //
+   // Codes that operate on one kind of variable.
+   //
+   struct PeepReg
+   {
+      Code push, drop;
+      Code addU, subU, mulU, divI, modI;
+      Code bAnd, bOrI, bOrX, shLU, shRI;
+      Code incU, decU;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::BC::ZDACS
+{
+   static PeepReg const PeepRegs[] =
+   {
+      {Code::Push_LocReg, Code::Drop_LocReg,
+         Code::AddU_LocReg, Code::SubU_LocReg, Code::MulU_LocReg,
+         Code::DivI_LocReg, Code::ModI_LocReg,
+         Code::BAnd_LocReg, Code::BOrI_LocReg, Code::BOrX_LocReg,
+         Code::ShLU_LocReg, Code::ShRI_LocReg,
+         Code::IncU_LocReg, Code::DecU_LocReg},
+
+      {Code::Push_ModReg, Code::Drop_ModReg,
+         Code::AddU_ModReg, Code::SubU_ModReg, Code::MulU_ModReg,
+         Code::DivI_ModReg, Code::ModI_ModReg,
+         Code::BAnd_ModReg, Code::BOrI_ModReg, Code::BOrX_ModReg,
+         Code::ShLU_ModReg, Code::ShRI_ModReg,
+         Code::IncU_ModReg, Code::DecU_ModReg},
+
+      {Code::Push_HubReg, Code::Drop_HubReg,
+         Code::AddU_HubReg, Code::SubU_HubReg, Code::MulU_HubReg,
+         Code::DivI_HubReg, Code::ModI_HubReg,
+         Code::BAnd_HubReg, Code::BOrI_HubReg, Code::BOrX_HubReg,
+         Code::ShLU_HubReg, Code::ShRI_HubReg,
+         Code::IncU_HubReg, Code::DecU_HubReg},
+
+      {Code::Push_GblReg, Code::Drop_GblReg,
+         Code::AddU_GblReg, Code::SubU_GblReg, Code::MulU_GblReg,
+         Code::DivI_GblReg, Code::ModI_GblReg,
+         Code::BAnd_GblReg, Code::BOrI_GblReg, Code::BOrX_GblReg,
+         Code::ShLU_GblReg, Code::ShRI_GblReg,
+         Code::IncU_GblReg, Code::DecU_GblReg},
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC::ZDACS
+{
+   //
+   // GetPeepReg
+   //
+   // Returns the variable kind that code operates on, if any.
+   //
+   static PeepReg const *GetPeepReg(Core::FastU code)
+   {
+      for(auto const &reg : PeepRegs)
+      {
+         for(Code c : {reg.push, reg.drop, reg.addU, reg.subU, reg.mulU,
+            reg.divI, reg.modI, reg.bAnd, reg.bOrI, reg.bOrX, reg.shLU,
+            reg.shRI, reg.incU, reg.decU})
+         {
+            if(static_cast<Core::FastU>(c) == code)
+               return &reg;
+         }
+      }
+
+      return nullptr;
+   }
+
+   //
+   // GetPeepRegOp
+   //
+   // Returns the compound assignment code for a stack operation.
+   //
+   static Code GetPeepRegOp(PeepReg const &reg, Core::FastU code)
+   {
+      switch(static_cast<Code>(code))
+      {
+      case Code::AddU: return reg.addU;
+      case Code::BAnd: return reg.bAnd;
+      case Code::BOrI: return reg.bOrI;
+      case Code::BOrX: return reg.bOrX;
+      case Code::DivI: return reg.divI;
+      case Code::ModI: return reg.modI;
+      case Code::MulU: return reg.mulU;
+      case Code::ShLU: return reg.shLU;
+      case Code::ShRI: return reg.shRI;
+      case Code::SubU: return reg.subU;
+      default:         return Code::Nop;
+      }
+   }
+
+   //
+   // IsPeepPush
+   //
+   // Codes that only push a value.
+   //
+   static bool IsPeepPush(Core::FastU code)
+   {
+      switch(static_cast<Code>(code))
+      {
+      case Code::Push_GblReg:
+      case Code::Push_HubReg:
+      case Code::Push_Lit:
+      case Code::Push_LitB:
+      case Code::Push_LocReg:
+      case Code::Push_ModReg:
+         return true;
+
+      default:
+         return false;
+      }
+   }
+
+   //
+   // ToSigned
+   //
+   static std::int_least32_t ToSigned(Core::FastU val)
+   {
+      val &= 0xFFFFFFFF;
+      return val & 0x80000000
+         ? -static_cast<std::int_least32_t>(0xFFFFFFFF - val) - 1
+         : static_cast<std::int_least32_t>(val);
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC::ZDACS
+{
+   //
+   // Info::genPeep
+   //
+   // Tries each rule against the codes just generated. A rule that applies
+   // replaces the codes at the end of the chunk by generating new ones, so
+   // rules may apply again to the result.
+   //
+   void Info::genPeep()
+   {
+      genPeep_DropPush() ||
+      genPeep_PushDrop() ||
+      genPeep_FoldBin()  ||
+      genPeep_FoldUna()  ||
+      genPeep_Comp()     ||
+      genPeep_IncDec();
+   }
+
+   //
+   // Info::genPeep_Comp
+   //
+   // Push_Reg x; Push y; Op; Drop_Reg x -> Push y; Op_Reg x
+   //
+   bool Info::genPeep_Comp()
+   {
+      auto &chunk = module->chunkCODE;
+      if(chunk.size() - moduleCodeFence < 4) return false;
+
+      auto code = chunk.end() - 4;
+
+      auto reg = GetPeepReg(code[0].code);
+      if(!reg || code[0].code != static_cast<Core::FastU>(reg->push) ||
+         code[3].code != static_cast<Core::FastU>(reg->drop) ||
+         !genPeepArg(code[0].args[0], code[3].args[0]))
+         return false;
+
+      if(!IsPeepPush(code[1].code))
+         return false;
+
+      auto op = GetPeepRegOp(*reg, code[2].code);
+      if(op == Code::Nop)
+         return false;
+
+      auto push = static_cast<Code>(code[1].code);
+      auto args = std::move(code[1].args);
+      auto var  = code[3].args[0];
+
+      chunk.drop(4);
+      genPeepHit("comp-assign");
+
+      genCode(push, std::move(args));
+      genCode(op, var);
+
+      return true;
+   }
+
+   //
+   // Info::genPeep_DropPush
+   //
+   // Drop_Reg x; Push_Reg x -> Copy; Drop_Reg x
+   //
+   bool Info::genPeep_DropPush()
+   {
+      auto &chunk = module->chunkCODE;
+      if(chunk.size() - moduleCodeFence < 2) return false;
+
+      auto code = chunk.end() - 2;
+
+      auto reg = GetPeepReg(code[0].code);
+      if(!reg || code[0].code != static_cast<Core::FastU>(reg->drop) ||
+         code[1].code != static_cast<Core::FastU>(reg->push) ||
+         !genPeepArg(code[0].args[0], code[1].args[0]))
+         return false;
+
+      auto drop = reg->drop;
+      auto var  = code[0].args[0];
+
+      chunk.drop(2);
+      genPeepHit("drop-push");
+
+      genCode(Code::Copy);
+      genCode(drop, var);
+
+      return true;
+   }
+
+   //
+   // Info::genPeep_FoldBin
+   //
+   // Push_Lit a; Push_Lit b; Op -> Push_Lit (a Op b)
+   //
+   bool Info::genPeep_FoldBin()
+   {
+      auto &chunk = module->chunkCODE;
+      if(chunk.size() - moduleCodeFence < 3) return false;
+
+      auto code = chunk.end() - 3;
+
+      Core::FastU l, r;
+      if(!genPeepLit(code[0], l) || !genPeepLit(code[1], r))
+         return false;
+
+      auto ls = ToSigned(l), rs = ToSigned(r);
+      Core::FastU val;
+
+      switch(static_cast<Code>(code[2].code))
+      {
+      case Code::AddU:    val = l + r;             break;
+      case Code::BAnd:    val = l & r;             break;
+      case Code::BOrI:    val = l | r;             break;
+      case Code::BOrX:    val = l ^ r;             break;
+      case Code::CmpI_GE: val = ls >= rs;          break;
+      case Code::CmpI_GT: val = ls >  rs;          break;
+      case Code::CmpI_LE: val = ls <= rs;          break;
+      case Code::CmpI_LT: val = ls <  rs;          break;
+      case Code::CmpU_EQ: val = l == r;            break;
+      case Code::CmpU_NE: val = l != r;            break;
+      case Code::LAnd:    val = l && r;            break;
+      case Code::LOrI:    val = l || r;            break;
+      case Code::MulU:    val = l * r;             break;
+      case Code::SubU:    val = l - r;             break;
+
+      // Leave division errors for run time.
+      case Code::DivI:
+         if(!rs || (ls == INT_LEAST32_MIN && rs == -1)) return false;
+         val = static_cast<Core::FastU>(ls / rs);
+         break;
+
+      case Code::ModI:
+         if(!rs || (ls == INT_LEAST32_MIN && rs == -1)) return false;
+         val = static_cast<Core::FastU>(ls % rs);
+         break;
+
+      case Code::ShLU:
+         if(r >= 32) return false;
+         val = l << r;
+         break;
+
+      case Code::ShRI:
+         if(r >= 32) return false;
+         val = static_cast<Core::FastU>(ls >> r);
+         break;
+
+      default:
+         return false;
+      }
+
+      chunk.drop(3);
+      genPeepHit("fold-binary");
+
+      genCode(Code::Push_Lit, val & 0xFFFFFFFF);
+
+      return true;
+   }
+
+   //
+   // Info::genPeep_FoldUna
+   //
+   // Push_Lit a; Op -> Push_Lit (Op a)
+   //
+   bool Info::genPeep_FoldUna()
+   {
+      auto &chunk = module->chunkCODE;
+      if(chunk.size() - moduleCodeFence < 2) return false;
+
+      auto code = chunk.end() - 2;
+
+      Core::FastU l;
+      if(!genPeepLit(code[0], l))
+         return false;
+
+      Core::FastU val;
+
+      switch(static_cast<Code>(code[1].code))
+      {
+      case Code::BNot: val = ~l;    break;
+      case Code::LNot: val = !l;    break;
+      case Code::NegI: val = 0 - l; break;
+
+      default:
+         return false;
+      }
+
+      chunk.drop(2);
+      genPeepHit("fold-unary");
+
+      genCode(Code::Push_Lit, val & 0xFFFFFFFF);
+
+      return true;
+   }
+
+   //
+   // Info::genPeep_IncDec
+   //
+   // Push_Lit 1; AddU_Reg x -> IncU_Reg x
+   // Push_Lit 1; SubU_Reg x -> DecU_Reg x
+   // Push_Lit identity; Op_Reg x -> (nothing)
+   //
+   bool Info::genPeep_IncDec()
+   {
+      auto &chunk = module->chunkCODE;
+      if(chunk.size() - moduleCodeFence < 2) return false;
+
+      auto code = chunk.end() - 2;
+
+      Core::FastU val;
+      if(!genPeepLit(code[0], val))
+         return false;
+
+      auto reg = GetPeepReg(code[1].code);
+      if(!reg) return false;
+
+      auto op  = static_cast<Code>(code[1].code);
+      auto var = code[1].args[0];
+
+      // Operations that leave the variable unchanged.
+      if(((op == reg->addU || op == reg->subU || op == reg->bOrI ||
+         op == reg->bOrX || op == reg->shLU || op == reg->shRI) && val == 0) ||
+         ((op == reg->mulU || op == reg->divI) && val == 1) ||
+         (op == reg->bAnd && val == 0xFFFFFFFF))
+      {
+         chunk.drop(2);
+         genPeepHit("nop-assign");
+         return true;
+      }
+
+      Code inc;
+      if(op == reg->addU)
+         inc = val == 1 ? reg->incU : val == 0xFFFFFFFF ? reg->decU : Code::Nop;
+      else if(op == reg->subU)
+         inc = val == 1 ? reg->decU : val == 0xFFFFFFFF ? reg->incU : Code::Nop;
+      else
+         inc = Code::Nop;
+
+      if(inc == Code::Nop)
+         return false;
+
+      chunk.drop(2);
+      genPeepHit("inc-dec");
+
+      genCode(inc, var);
+
+      return true;
+   }
+
+   //
+   // Info::genPeep_PushDrop
+   //
+   // Push x; Drop_Nul -> (nothing)
+   //
+   bool Info::genPeep_PushDrop()
+   {
+      auto &chunk = module->chunkCODE;
+      if(chunk.size() - moduleCodeFence < 2) return false;
+
+      auto code = chunk.end() - 2;
+
+      if(!IsPeepPush(code[0].code) ||
+         code[1].code != static_cast<Core::FastU>(Code::Drop_Nul))
+         return false;
+
+      chunk.drop(2);
+      genPeepHit("push-drop");
+
+      return true;
+   }
+
+   //
+   // Info::genPeepArg
+   //
+   // Checks if two arguments are known to have the same value.
+   //
+   bool Info::genPeepArg(ElemArg const &l, ElemArg const &r)
+   {
+      if(l.exp == r.exp && l.val == r.val)
+         return true;
+
+      if((l.exp && !l.exp->isValue()) || (r.exp && !r.exp->isValue()))
+         return false;
+
+      return getWord(l) == getWord(r);
+   }
+
+   //
+   // Info::genPeepHit
+   //
+   void Info::genPeepHit(char const *rule)
+   {
+      ++peepHits[rule];
+   }
+
+   //
+   // Info::genPeepJump
+   //
+   // Jump targets that are themselves unconditional jumps are replaced by
+   // that jump's target. This does not change any code's size, so it runs
+   // after all codes have been generated.
+   //
+   void Info::genPeepJump()
+   {
+      auto &chunk = module->chunkCODE;
+
+      std::unordered_map<Core::FastU, ElemCODE const *> codeByPos;
+      for(auto const &code : chunk)
+         codeByPos.emplace(CodeBase() + code.cpos, &code);
+
+      auto thread = [&](ElemArg &arg)
+      {
+         if(arg.exp && !arg.exp->isValue())
+            return;
+
+         Core::FastU pos = getWord(arg), next = pos;
+
+         // Follow a bounded number of jumps, in case of loops.
+         for(int n = 0; n != 16; ++n)
+         {
+            auto itr = codeByPos.find(next);
+            if(itr == codeByPos.end() ||
+               itr->second->code != static_cast<Core::FastU>(Code::Jump_Lit))
+               break;
+
+            auto const &target = itr->second->args[0];
+            if(target.exp && !target.exp->isValue())
+               break;
+
+            next = getWord(target);
+         }
+
+         if(next != pos)
+         {
+            arg = next;
+            genPeepHit("jump-thread");
+         }
+      };
+
+      for(auto &code : chunk) switch(static_cast<Code>(code.code))
+      {
+      case Code::Jcnd_Nil:
+      case Code::Jcnd_Tru:
+      case Code::Jump_Lit:
+         thread(code.args[0]);
+         break;
+
+      case Code::Jcnd_Lit:
+         thread(code.args[1]);
+         break;
+
+      case Code::Jcnd_Tab:
+         for(std::size_t i = 2, e = code.args.size(); i < e; i += 2)
+            thread(code.args[i]);
+         break;
+
+      default:
+         break;
+      }
+   }
+
+   //
+   // Info::genPeepLit
+   //
+   // Checks for a literal push with a known value.
+   //
+   bool Info::genPeepLit(ElemCODE const &code, Core::FastU &val)
+   {
+      if(code.code != static_cast<Core::FastU>(Code::Push_Lit) &&
+         code.code != static_cast<Core::FastU>(Code::Push_LitB))
+         return false;
+
+      auto const &arg = code.args[0];
+      if(arg.exp && !arg.exp->isValue())
+         return false;
+
+      val = getWord(arg) & 0xFFFFFFFF;
+      return true;
+   }
+}
+
+// EOF
+
@@ -144,7 +144,8 @@ namespace GDCC::BC::ZDACS
    //
    Core::FastU Info::lenChunkCODE()
    {
-      return 8 + module->chunkCODE.getPos();
+      // Compressed code is padded to keep following chunks word-aligned.
+      return 8 + ((module->chunkCODE.getPos() + 3) & ~static_cast<Core::FastU>(3));
    }
 
    //
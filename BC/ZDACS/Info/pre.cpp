@@ -40,7 +40,7 @@ namespace GDCC::BC::ZDACS
       }
 
       if(func->defin && func->allocAut)
-         preStmntCall("___GDCC__Plsa", 1, 1);
+         preStmntCall(FuncAllocAut, 1, 1);
 
       InfoBase::preFunc();
    }
@@ -72,10 +72,10 @@ namespace GDCC::BC::ZDACS
       case IR::CodeBase::CmpLE: preStmnt_CmpLE(); break;
       case IR::CodeBase::CmpLT: preStmnt_CmpLT(); break;
       case IR::CodeBase::CmpNE: preStmnt_CmpNE(); break;
-      case IR::CodeBase::Div:   preStmnt_Div(); break;
+      case IR::CodeBase::Div:   preStmnt_Div_Lit(); preStmnt_Div(); break;
       case IR::CodeBase::DivX:  preStmnt_DivX(); break;
-      case IR::CodeBase::Mod:   preStmnt_Mod(); break;
-      case IR::CodeBase::Mul:   preStmnt_Mul(); break;
+      case IR::CodeBase::Mod:   preStmnt_Mod_Lit(); preStmnt_Mod(); break;
+      case IR::CodeBase::Mul:   preStmnt_Mul_Lit(); preStmnt_Mul(); break;
       case IR::CodeBase::MulX:  preStmnt_MulX(); break;
       case IR::CodeBase::Retn:  preStmnt_Retn(); break;
       case IR::CodeBase::Rjnk:  preStmnt_Rjnk(); break;
@@ -15,12 +15,17 @@
 #include "BC/ZDACS/Code.hpp"
 #include "BC/ZDACS/Module.hpp"
 
+#include "Core/Exception.hpp"
+
+#include "IR/Exp.hpp"
 #include "IR/Function.hpp"
 #include "IR/Program.hpp"
 
 #include "Target/CallType.hpp"
 #include "Target/Info.hpp"
 
+#include <algorithm>
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -34,9 +39,15 @@ namespace GDCC::BC::ZDACS
    void Info::put()
    {
       if(Target::FormatCur == Target::Format::ACS0)
+      {
+         putReserve(16 + module->chunkCODE.getPos());
          putACS0();
+      }
       else
+      {
+         putReserve(24 + lenChunk());
          putACSE();
+      }
    }
 
    //
@@ -117,7 +128,7 @@ namespace GDCC::BC::ZDACS
       }
       else
       {
-         putData("ACSE", 4);
+         putData(IsCompressed() ? "ACSe" : "ACSE", 4);
          putWord(16);
       }
 
@@ -132,7 +143,7 @@ namespace GDCC::BC::ZDACS
       if(UseFakeACS0)
       {
          putWord(16);
-         putData("ACSE", 4);
+         putData(IsCompressed() ? "ACSe" : "ACSE", 4);
          putACS0_Scripts();
          putWord(0);
       }
@@ -143,9 +154,7 @@ namespace GDCC::BC::ZDACS
    //
    void Info::putByte(Core::FastU i)
    {
-      out->put(i & 0xFF);
-
-      putPos += 1;
+      *putAlloc(1) = static_cast<char>(i & 0xFF);
    }
 
    //
@@ -156,7 +165,8 @@ namespace GDCC::BC::ZDACS
       for(auto &code : module->chunkCODE) switch(static_cast<Code>(code.code))
       {
       case Code::Jcnd_Tab:
-         putWord(code.code);
+         putCodeOp(code.code);
+         while(putPos & 3) putByte(0);
          putWord(getWord(code.args[0]));
 
          // Sort and write case data.
@@ -191,22 +201,67 @@ namespace GDCC::BC::ZDACS
          break;
 
       default:
-         putWord(code.code);
-         for(auto const &arg : code.args)
-            putWord(getWord(arg));
+         putCodeOp(code.code);
+         for(std::size_t i = 0, e = code.args.size(); i != e; ++i)
+            putCodeArg(code.args[i], GetCodeArgSize(static_cast<Code>(code.code), i));
+         break;
+      }
+   }
+
+   //
+   // Info::putCodeArg
+   //
+   void Info::putCodeArg(ElemArg const &arg, Core::FastU size)
+   {
+      Core::FastU w = getWord(arg);
+
+      switch(size)
+      {
+      case 1:
+         if(w > 0xFF)
+            Core::Error(arg.exp ? arg.exp->pos : Core::Origin{},
+               "argument too large for compressed ACSe: ", w);
+         putByte(w);
+         break;
+
+      case 2:
+         if(w > 0xFFFF)
+            Core::Error(arg.exp ? arg.exp->pos : Core::Origin{},
+               "argument too large for compressed ACSe: ", w);
+         putHWord(w);
+         break;
+
+      default:
+         putWord(w);
          break;
       }
    }
 
+   //
+   // Info::putCodeOp
+   //
+   void Info::putCodeOp(Core::FastU code)
+   {
+      if(!IsCompressed())
+         putWord(code);
+      else if(code < 240)
+         putByte(code);
+      else
+      {
+         putByte(240 + ((code - 240) >> 8));
+         putByte((code - 240) & 0xFF);
+      }
+   }
+
    //
    // Info::putHWord
    //
    void Info::putHWord(Core::FastU i)
    {
-      out->put((i >> 0) & 0xFF);
-      out->put((i >> 8) & 0xFF);
+      char *data = putAlloc(2);
 
-      putPos += 2;
+      data[0] = static_cast<char>((i >> 0) & 0xFF);
+      data[1] = static_cast<char>((i >> 8) & 0xFF);
    }
 
    //
@@ -214,22 +269,23 @@ namespace GDCC::BC::ZDACS
    //
    void Info::putString(Core::String s)
    {
-      for(auto i = s.begin(), e = s.end(); i != e; ++i) switch(*i)
+      auto isEsc = [](char c) {return c == '\0' || c == '\\';};
+
+      for(auto i = s.begin(), e = s.end(); i != e; ++i)
       {
-      case '\0':
-         if('0' <= i[1] && i[1] <= '7')
+         // Write runs of unescaped characters at once.
+         auto run = std::find_if(i, e, isEsc);
+         putData(i, run - i);
+
+         if((i = run) == e)
+            break;
+
+         if(*i == '\\')
+            putData("\\\\", 2);
+         else if('0' <= i[1] && i[1] <= '7')
             putData("\\000", 4);
          else
             putData("\\0", 2);
-         break;
-
-      case '\\':
-         putData("\\\\", 2);
-         break;
-
-      default:
-         putByte(*i);
-         break;
       }
 
       putByte('\0');
@@ -284,12 +340,12 @@ namespace GDCC::BC::ZDACS
    //
    void Info::putWord(Core::FastU i)
    {
-      out->put((i >>  0) & 0xFF);
-      out->put((i >>  8) & 0xFF);
-      out->put((i >> 16) & 0xFF);
-      out->put((i >> 24) & 0xFF);
+      char *data = putAlloc(4);
 
-      putPos += 4;
+      data[0] = static_cast<char>((i >>  0) & 0xFF);
+      data[1] = static_cast<char>((i >>  8) & 0xFF);
+      data[2] = static_cast<char>((i >> 16) & 0xFF);
+      data[3] = static_cast<char>((i >> 24) & 0xFF);
    }
 }
 
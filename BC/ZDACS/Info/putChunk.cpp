@@ -203,9 +203,11 @@ namespace GDCC::BC::ZDACS
    void Info::putChunkCODE()
    {
       putData("\0\0\0\0", 4);
-      putWord(module->chunkCODE.getPos());
+      putWord((module->chunkCODE.getPos() + 3) & ~static_cast<Core::FastU>(3));
 
       putCode();
+
+      while(putPos & 3) putByte(0);
    }
 
    //
@@ -222,6 +222,9 @@ namespace GDCC::BC::ZDACS
       void add(Core::FastU cpos, Core::FastU size, Core::FastU code, ElemArgs &&args)
          {elem.emplace_back(cpos, size, code, std::move(args));}
 
+      void drop(std::size_t n)
+         {elem.erase(elem.end() - n, elem.end());}
+
       Core::FastU getPos()
          {return elem.empty() ? 0 : elem.back().cpos + elem.back().size;}
    };
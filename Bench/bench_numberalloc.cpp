@@ -0,0 +1,150 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2025 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Number allocation benchmark.
+//
+//-----------------------------------------------------------------------------
+
+#include "Core/NumberAlloc.hpp"
+
+#include "Core/Number.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+//
+// BenchAlloc
+//
+// Allocates and frees mostly small ranges, keeping a bounded number live as
+// SR::Function does for temporaries.
+//
+static void BenchAlloc(std::size_t count)
+{
+   using GDCC::Core::FastU;
+
+   using Alloc = GDCC::Core::NumberAlloc<FastU>;
+
+   std::mt19937 rng{1};
+   std::uniform_int_distribution<FastU> kindDist{0, 99};
+   std::uniform_int_distribution<FastU> smallDist{1, 4};
+   std::uniform_int_distribution<FastU> largeDist{5, 64};
+
+   Alloc                             alloc;
+   std::vector<Alloc::Block const *> live;
+   FastU                             sum = 0;
+
+   auto start = std::chrono::steady_clock::now();
+
+   for(std::size_t i = 0; i != count; ++i)
+   {
+      FastU kind = kindDist(rng);
+
+      if(kind < 45 && !live.empty())
+      {
+         // Free a random live range.
+         std::size_t idx = rng() % live.size();
+         alloc.free(live[idx]);
+         live[idx] = live.back();
+         live.pop_back();
+      }
+      else
+      {
+         FastU size  = kind < 90 ? smallDist(rng) : largeDist(rng);
+         auto  block = alloc.alloc(size);
+         live.push_back(block);
+         sum = sum * 31 + block->lo;
+      }
+   }
+
+   std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+   std::printf("NumberAlloc: %zu operations in %.4f seconds (%.0f/sec), "
+      "max %llu, checksum %016llx\n", count, time.count(), count / time.count(),
+      static_cast<unsigned long long>(alloc.max()),
+      static_cast<unsigned long long>(sum));
+}
+
+//
+// BenchAllocMerge
+//
+// Mixes fixed address allocations, which leave holes, with allocations of
+// mostly small sizes that fill them.
+//
+static void BenchAllocMerge(std::size_t count)
+{
+   using GDCC::Core::FastU;
+
+   std::mt19937 rng{1};
+   std::uniform_int_distribution<FastU> kindDist{0, 99};
+   std::uniform_int_distribution<FastU> smallDist{1, 4};
+   std::uniform_int_distribution<FastU> largeDist{5, 256};
+   std::uniform_int_distribution<FastU> addrDist{0, count * 8};
+
+   GDCC::Core::NumberAllocMerge<FastU> alloc;
+   FastU sum = 0;
+
+   auto start = std::chrono::steady_clock::now();
+
+   for(std::size_t i = 0; i != count; ++i)
+   {
+      FastU kind = kindDist(rng);
+      FastU size = kind < 90 ? smallDist(rng) : largeDist(rng);
+
+      if(kind % 4 == 0)
+      {
+         // Fixed address.
+         FastU addr = addrDist(rng);
+         alloc.allocAt(size, addr);
+         sum = sum * 31 + addr;
+      }
+      else if(kind % 4 == 1)
+      {
+         // Minimum address.
+         sum = sum * 31 + alloc.alloc(size, addrDist(rng));
+      }
+      else
+         sum = sum * 31 + alloc.alloc(size);
+   }
+
+   std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+   std::printf("NumberAllocMerge: %zu allocations in %.4f seconds (%.0f/sec), "
+      "checksum %016llx\n", count, time.count(), count / time.count(),
+      static_cast<unsigned long long>(sum));
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+//
+// main
+//
+// Usage: gdcc-bench-numberalloc [operations]
+//
+// Runs each allocator with the same number of operations. Prints a checksum
+// of the addresses so that implementations can be compared.
+//
+int main(int argc, char *argv[])
+{
+   std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+   BenchAlloc(count);
+   BenchAllocMerge(count);
+}
+
+// EOF
@@ -0,0 +1,95 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2025 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// String intern throughput benchmark.
+//
+//-----------------------------------------------------------------------------
+
+#include "Core/String.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+//
+// BenchIntern
+//
+// Each thread interns count names. Half of them are shared by every thread,
+// so that lookups of existing strings are measured along with inserts.
+//
+static double BenchIntern(std::size_t threadC, std::size_t count, std::size_t run)
+{
+   std::vector<std::vector<std::string>> names(threadC);
+   for(std::size_t t = 0; t != threadC; ++t)
+   {
+      names[t].reserve(count);
+      for(std::size_t i = 0; i != count; ++i)
+      {
+         if(i & 1)
+            names[t].push_back("bench$" + std::to_string(run) + "$shared$" + std::to_string(i));
+         else
+            names[t].push_back("bench$" + std::to_string(run) + "$" +
+               std::to_string(t) + "$" + std::to_string(i));
+      }
+   }
+
+   auto work = [&](std::size_t t)
+   {
+      for(auto const &name : names[t])
+         GDCC::Core::String{name.data(), name.size()};
+   };
+
+   auto start = std::chrono::steady_clock::now();
+
+   std::vector<std::thread> threads;
+   for(std::size_t t = 1; t < threadC; ++t)
+      threads.emplace_back(work, t);
+   work(0);
+   for(auto &thread : threads)
+      thread.join();
+
+   std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+   return time.count();
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+//
+// main
+//
+// Usage: gdcc-bench-string [names per thread]
+//
+int main(int argc, char *argv[])
+{
+   std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+   std::size_t run   = 0;
+
+   std::printf("%8s %12s %10s %14s\n", "threads", "interns", "seconds", "interns/sec");
+
+   for(std::size_t threadC : {1, 4, 16})
+   {
+      double      time  = BenchIntern(threadC, count, run++);
+      std::size_t total = threadC * count;
+
+      std::printf("%8zu %12zu %10.4f %14.0f\n", threadC, total, time, total / time);
+   }
+}
+
+// EOF
+
@@ -271,6 +271,21 @@ namespace GDCC::CC
       ctx.expect(Core::TOK_ParenC);
    }
 
+   //
+   // ParseAttr_inline
+   //
+   // attribute-inline:
+   //    attribute-inline-name
+   //
+   // attribute-inline-name:
+   //    <inline>
+   //    <__inline>
+   //
+   static void ParseAttr_inline(Parser &, Scope &, SR::Attribute &attr)
+   {
+      attr.funcInlineAlways = true;
+   }
+
    //
    // ParseAttr_no_init
    //
@@ -301,6 +316,21 @@ namespace GDCC::CC
       attr.funcNoInitDelay = true;
    }
 
+   //
+   // ParseAttr_noinline
+   //
+   // attribute-noinline:
+   //    attribute-noinline-name
+   //
+   // attribute-noinline-name:
+   //    <noinline>
+   //    <__noinline>
+   //
+   static void ParseAttr_noinline(Parser &, Scope &, SR::Attribute &attr)
+   {
+      attr.funcInlineNever = true;
+   }
+
    //
    // ParseAttr_optional_args
    //
@@ -432,6 +462,9 @@ namespace GDCC::CC
       case Core::STR_extern: case Core::STR___extern:
          ParseAttr_extern(*this, scope, attr); break;
 
+      case Core::STR_inline: case Core::STR___inline:
+         ParseAttr_inline(*this, scope, attr); break;
+
       case Core::STR_no_init: case Core::STR___no_init:
          ParseAttr_no_init(*this, scope, attr); break;
 
@@ -441,6 +474,9 @@ namespace GDCC::CC
       case Core::STR_no_init_delay: case Core::STR___no_init_delay:
          ParseAttr_no_init_delay(*this, scope, attr); break;
 
+      case Core::STR_noinline: case Core::STR___noinline:
+         ParseAttr_noinline(*this, scope, attr); break;
+
       case Core::STR_optional_args: case Core::STR___optional_args:
          ParseAttr_optional_args(*this, scope, attr); break;
 
@@ -187,6 +187,8 @@ namespace GDCC::CC
 
          fn->declAuto    = attr.declAuto;
          fn->delay       = attr.funcDelay;
+         fn->inlAlways   = attr.funcInlineAlways;
+         fn->inlNever    = attr.funcInlineNever;
          fn->noInitDelay = attr.funcNoInitDelay;
 
          itr = globalFunc.emplace(glyph, fn).first;
@@ -201,6 +203,9 @@ namespace GDCC::CC
 
          fn->delay = attr.funcDelay;
 
+         fn->inlAlways |= attr.funcInlineAlways;
+         fn->inlNever  |= attr.funcInlineNever;
+
          // If previously auto-declared, replace type information.
          if(fn->declAuto)
          {
@@ -17,9 +17,14 @@
 #include "CC/Scope/Case.hpp"
 
 #include "Core/Exception.hpp"
+#include "Core/Option.hpp"
 
 #include "IR/Block.hpp"
 #include "IR/Glyph.hpp"
+#include "IR/Linkage.hpp"
+#include "IR/Program.hpp"
+
+#include "Option/Int.hpp"
 
 #include "SR/Exp.hpp"
 #include "SR/Function.hpp"
@@ -36,6 +41,68 @@
 namespace GDCC::CC
 {
    using CodePair = std::pair<IR::Code, IR::Code>;
+   using CaseList = std::vector<Scope_Case::Case const *>;
+}
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::CC
+{
+   //
+   // --switch-table-min
+   //
+   static Option::Int<std::size_t> TableCountMin
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("switch-table-min")
+         .setGroup("codegen")
+         .setDescS("Sets the fewest cases for a switch jump table.")
+         .setDescL(
+            "Sets the fewest cases for a switch jump table. Applies to "
+            "multi-word conditions on targets with dynamic jumps.\n"
+            "\n"
+            "Default is 4."),
+
+      4
+   };
+
+   //
+   // --switch-table-min-word
+   //
+   static Option::Int<std::size_t> TableCountMinWord
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("switch-table-min-word")
+         .setGroup("codegen")
+         .setDescS("Sets the fewest cases for a single-word switch jump table.")
+         .setDescL(
+            "Sets the fewest cases for a switch jump table with a single-word "
+            "condition. Below this, ZDACS uses its native case search, which "
+            "takes fewer instructions than the table.\n"
+            "\n"
+            "Default is 4097, which is above the largest table, so jump "
+            "tables are off for single-word switches unless this is set. "
+            "Multi-word switches use --switch-table-min."),
+
+      4097
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::CC
+{
+   // Maximum number of jump table entries per case.
+   static constexpr std::size_t TableDensity = 2;
+
+   // Maximum number of jump table entries.
+   static constexpr std::size_t TableSizeMax = 4096;
 }
 
 
@@ -116,7 +183,8 @@ namespace GDCC::CC
 
             // Compare condition to case value for equality.
             ctx.block.addStmnt(codes.second,
-               IR::Block::Stk(), cond.getArg(), caseValue);
+               IR::Block::Stk(), cond.getArg(),
+               IR::Arg_Lit(cond.sizeBytes(), caseValue));
 
             // If true, branch to case.
             ctx.block.addStmnt(IR::CodeBase::Jcnd_Tru, IR::Block::Stk(), caseLabel);
@@ -151,13 +219,13 @@ namespace GDCC::CC
    }
 
    //
-   // GenCond_Search
+   // GenCond_Cases
    //
-   static void GenCond_Search(Statement_Switch const *stmnt,
-      SR::GenStmntCtx const &ctx, CodePair const &codes)
+   // Collects and sorts cases, with a null entry at each end.
+   //
+   static CaseList GenCond_Cases(Statement_Switch const *stmnt)
    {
-      // Collect and sort cases.
-      std::vector<Scope_Case::Case const *> cases;
+      CaseList cases;
       cases.reserve(stmnt->scope.size() + 2);
 
       cases.emplace_back(nullptr);
@@ -169,6 +237,36 @@ namespace GDCC::CC
          [](Scope_Case::Case const *l, Scope_Case::Case const *r)
             {return l->value < r->value;});
 
+      return cases;
+   }
+
+   //
+   // GenCond_IsTable
+   //
+   // Returns true if the cases are numerous and dense enough for a jump
+   // table. Only ZDACS has dynamic jumps.
+   //
+   static bool GenCond_IsTable(Statement_Switch const *stmnt, CaseList const &cases)
+   {
+      if(!Target::IsFamily_ZDACS())
+         return false;
+
+      std::size_t count = cases.size() - 2;
+      if(count < (stmnt->cond->getType()->getSizeWords() == 1 ?
+         TableCountMinWord : TableCountMin))
+         return false;
+
+      Core::Integ range = cases[count]->value - cases[1]->value + 1;
+
+      return range <= count * TableDensity && range <= TableSizeMax;
+   }
+
+   //
+   // GenCond_Search
+   //
+   static void GenCond_Search(Statement_Switch const *stmnt,
+      SR::GenStmntCtx const &ctx, CodePair const &codes, CaseList const &cases)
+   {
       // Evaluate condition and store in temporary.
       stmnt->cond->genStmntStk(ctx);
 
@@ -180,6 +278,87 @@ namespace GDCC::CC
          cases.data() + cases.size() - 1);
    }
 
+   //
+   // GenCond_Table
+   //
+   // Branches through a static table of dynamic jump targets indexed by the
+   // condition less the lowest case. Values out of range go to default.
+   //
+   static void GenCond_Table(Statement_Switch const *stmnt,
+      SR::GenStmntCtx const &ctx, CaseList const &cases)
+   {
+      auto        pos   = stmnt->pos;
+      auto        w     = Target::GetWordBytes();
+      std::size_t count = cases.size() - 2;
+      auto        low   = cases[1]->value;
+      auto        range = Core::NumberCast<Core::FastU>(
+         Core::Integ(cases[count]->value - low + 1));
+
+      // Generate dynamic jump target for a label.
+      auto genDJump = [&](Core::String label)
+      {
+         auto &djump = ctx.prog.getDJump(ctx.fn->genLabel());
+
+         djump.label = label;
+         djump.alloc = true;
+         djump.defin = true;
+
+         ctx.prog.getGlyphData(djump.glyph).type = IR::Type_DJump();
+
+         return IR::ExpCreate_Glyph({ctx.prog, djump.glyph}, pos);
+      };
+
+      // Fill table, with gaps going to default.
+      Core::Array<IR::Exp::CRef> elemV{range,
+         genDJump(stmnt->scope.getLabelDefault(false))};
+
+      for(auto c = cases.begin() + 1, e = cases.end() - 1; c != e; ++c)
+      {
+         auto idx = Core::NumberCast<Core::FastU>(Core::Integ((*c)->value - low));
+         elemV[idx] = genDJump((*c)->label);
+      }
+
+      // Generate table object.
+      auto &tab = ctx.prog.getObject(ctx.fn->genLabel());
+
+      tab.initi = IR::ExpCreate_Array(IR::Type_DJump(), std::move(elemV), pos);
+      tab.linka = IR::Linkage::IntC;
+      tab.space = {IR::AddrBase::Sta, Core::STR_};
+      tab.words = range;
+      tab.alloc = true;
+      tab.defin = true;
+
+      auto tabT = SR::Type::Label->getTypePointer();
+      ctx.prog.getGlyphData(tab.glyph).type = IR::Type_Point(IR::AddrBase::Sta,
+         Core::STR_, tabT->getSizePoint(), tabT->getSizeShift());
+
+      // Evaluate condition and store in temporary.
+      stmnt->cond->genStmntStk(ctx);
+
+      SR::Temporary tmp{ctx, pos, stmnt->cond->getType()->getSizeWords()};
+      IR::Type_Fixed tmpT{tmp.size() * Target::GetWordBits(), 0, false, false};
+
+      ctx.block.addStmnt(IR::CodeBase::Move, tmp.getArg(), tmp.getArgStk());
+
+      // Offset condition to table index.
+      ctx.block.addStmnt(IR::CodeBase::Sub+'U', tmp.getArg(), tmp.getArg(),
+         IR::Arg_Lit(tmp.sizeBytes(), GenCond_GenValue(stmnt, cases[1])));
+
+      // Check bounds as unsigned, so values below the lowest case also fail.
+      ctx.block.setArgSize().addStmnt(IR::CodeBase::CmpGT+'U', IR::Block::Stk(), tmp.getArg(),
+         IR::Arg_Lit(tmp.sizeBytes(), IR::ExpCreate_Value(
+            IR::Value_Fixed(Core::NumberCast<Core::Integ>(range - 1), tmpT), pos)));
+
+      ctx.block.addStmnt(IR::CodeBase::Jcnd_Tru, IR::Block::Stk(),
+         IR::Glyph(ctx.prog, stmnt->scope.getLabelDefault(false)));
+
+      // Load target from table and branch.
+      ctx.block.addStmnt(IR::CodeBase::Add+'U', IR::Block::Stk(),
+         tmp.getArg(0), IR::Glyph(ctx.prog, tab.glyph));
+
+      ctx.block.addStmnt(IR::CodeBase::Jdyn, IR::Arg_Sta(w, IR::Arg_Stk(w)));
+   }
+
    //
    // GenCond_Search_Jcnd_Tab
    //
@@ -243,10 +422,14 @@ namespace GDCC::CC
    void Statement_Switch::v_genStmnt(SR::GenStmntCtx const &ctx) const
    {
       // Generate condition.
-      if(Target::IsFamily_ZDACS() && cond->getType()->getSizeWords() == 1)
+      auto cases = GenCond_Cases(this);
+
+      if(GenCond_IsTable(this, cases))
+         GenCond_Table(this, ctx, cases);
+      else if(Target::IsFamily_ZDACS() && cond->getType()->getSizeWords() == 1)
          GenCond_Search_Jcnd_Tab(this, ctx);
       else
-         GenCond_Search(this, ctx, GenCond_Codes(this, cond->getType()));
+         GenCond_Search(this, ctx, GenCond_Codes(this, cond->getType()), cases);
 
       // Generate body.
       body->genStmnt(ctx);
@@ -120,6 +120,8 @@ namespace GDCC::CC
    {
       static std::map<SR::Type::CRef, Type_Div::CRef> divs;
 
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       auto itr = divs.find(type->getTypeQual());
 
       if(itr == divs.end())
@@ -174,9 +176,14 @@ namespace GDCC::CC
       isUnion { isUnion_},
 
       next{&Head},
-      prev{Head.prev},
+      prev{nullptr},
       type{type_}
    {
+      std::lock_guard<std::recursive_mutex> lock{SR::Type::GetMutex()};
+
+      // The list may change until the lock is held.
+      prev = Head.prev;
+
       next->prev = this;
       prev->next = this;
    }
@@ -188,6 +195,8 @@ namespace GDCC::CC
    {
       if(!type) Cleanup();
 
+      std::lock_guard<std::recursive_mutex> lock{SR::Type::GetMutex()};
+
       next->prev = prev;
       prev->next = next;
    }
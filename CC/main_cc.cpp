@@ -34,12 +34,22 @@ static void MakeC()
 {
    GDCC::IR::Program prog;
 
+   std::vector<std::function<void(GDCC::IR::Program &)>> jobs;
+
+   auto addJob = [&](char const *arg)
+   {
+      jobs.emplace_back([arg](GDCC::IR::Program &p)
+         {GDCC::CC::ParseFile(arg, p);});
+   };
+
    // Process inputs.
    for(auto const &arg : GDCC::Core::GetOptionArgs())
-      GDCC::CC::ParseFile(arg, prog);
+      addJob(arg);
 
    for(auto const &arg : GDCC::Core::GetOptions().optSysSource)
-      GDCC::CC::ParseFile(arg, prog);
+      addJob(arg);
+
+   GDCC::LD::ProcessJobs(prog, jobs);
 
    // Write output.
    GDCC::LD::Link(prog, GDCC::Core::GetOptionOutput());
@@ -66,6 +76,7 @@ int main(int argc, char *argv[])
       "Compiles C source into IR data. Output defaults to last loose "
       "argument.";
 
+   opts.optJobs.insert(&opts.list);
    opts.optLibPath.insert(&opts.list);
    opts.optSysSource.insert(&opts.list);
 
@@ -25,6 +25,7 @@
 
 #include "Target/Info.hpp"
 
+#include <array>
 #include <climits>
 #include <cstring>
 #include <ctime>
@@ -455,12 +456,21 @@ namespace GDCC::CPP
 
       // Set up __DATE__ and __TIME__.
       {
-         std::time_t t = std::time(nullptr);
+         // asctime and gmtime are not reentrant, so only call them once. This
+         // also gives every source compiled by one process the same time.
+         static std::array<char, 26> const timeStr = []()
+         {
+            std::time_t t = std::time(nullptr);
+            std::array<char, 26> s;
+            std::memcpy(s.data(), std::asctime(std::gmtime(&t)), 26);
+            return s;
+         }();
+
          char str[21];
 
          // asctime:  'Ddd Mmm dd hh:mm:ss yyyy\n\0'
          // str:         ' Mmm dd hh:mm:ss yyyy'
-         std::memcpy(str, std::asctime(std::gmtime(&t)) + 3, 21);
+         std::memcpy(str, timeStr.data() + 3, 21);
 
          // str:      ' Mmm dd"hh:mm:ss"yyyy'
          // __TIME__:        '"hh:mm:ss"'
@@ -59,7 +59,7 @@ namespace GDCC::Core
    //
    void WriteStrN(std::ostream &out, String in, std::size_t n)
    {
-      for(auto itr = in.begin(), end = in.end(); n && in != end; ++itr, --n)
+      for(auto itr = in.begin(), end = in.end(); n && itr != end; ++itr, --n)
          out.put(*itr);
 
       for(; n; --n)
@@ -15,6 +15,7 @@
 
 #include "../Core/Types.hpp"
 
+#include <atomic>
 #include <functional>
 
 
@@ -259,7 +260,34 @@ namespace GDCC::Core
       CounterBase &operator = (CounterBase const &) {return *this;}
       CounterBase &operator = (CounterBase &&) {return *this;}
 
-      mutable unsigned refCount;
+      //
+      // TryRef
+      //
+      // Returns a reference to p, unless its count has already reached zero.
+      // Used to safely acquire references from non-owning caches.
+      //
+      template<typename T>
+      static CounterPtr<T const> TryRef(T const *p)
+      {
+         if(!p) return nullptr;
+
+         CounterBase const *base = p;
+         for(unsigned n = base->refCount; n;)
+         {
+            if(base->refCount.compare_exchange_weak(n, n + 1))
+            {
+               CounterPtr<T const> ref{p};
+               --base->refCount;
+               return ref;
+            }
+         }
+
+         return nullptr;
+      }
+
+      // Atomic so that shared objects (such as interned types) can be
+      // referenced from multiple threads.
+      mutable std::atomic<unsigned> refCount;
 
 
       [[noreturn]]
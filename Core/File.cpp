@@ -229,6 +229,19 @@ namespace GDCC::Core
 
       return statBuf.st_size;
    }
+
+   //
+   // IsFile
+   //
+   bool IsFile(char const *filename)
+   {
+      struct stat statBuf;
+
+      if(stat(filename, &statBuf))
+         return false;
+
+      return S_ISREG(statBuf.st_mode);
+   }
 }
 
 // EOF
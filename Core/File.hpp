@@ -66,6 +66,8 @@ namespace GDCC::Core
    FileOpenStream(char const *filename, std::ios_base::openmode which);
 
    std::size_t FileSize(char const *filename);
+
+   bool IsFile(char const *filename);
 }
 
 #endif//GDCC__Core__File_H__
@@ -15,6 +15,10 @@
 
 #include "../Core/List.hpp"
 
+#include <cstdint>
+#include <functional>
+#include <map>
+
 
 //----------------------------------------------------------------------------|
 // Types                                                                      |
@@ -22,9 +26,187 @@
 
 namespace GDCC::Core
 {
+   //
+   // NumberAllocFree
+   //
+   // Unused blocks ordered by address. Each node also holds the largest
+   // size in its subtree, so the lowest block that fits a request is found
+   // in one descent. Blocks must be removed before their address or size
+   // is changed.
+   //
+   template<typename Block, typename T>
+   class NumberAllocFree
+   {
+   public:
+      NumberAllocFree() : root{nullptr}, seed{1} {}
+      NumberAllocFree(NumberAllocFree const &) = delete;
+      ~NumberAllocFree() {destroy(root);}
+
+      NumberAllocFree &operator = (NumberAllocFree const &) = delete;
+
+      //
+      // erase
+      //
+      void erase(Block const *block)
+      {
+         erase(root, block);
+      }
+
+      //
+      // find
+      //
+      // Returns the lowest block at or after min that can hold size.
+      //
+      Block *find(T const &size, T const &min) const
+      {
+         return find(root, size, min);
+      }
+
+      //
+      // insert
+      //
+      void insert(Block *block)
+      {
+         // Xorshift, so that the tree shape does not depend on addresses.
+         seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+
+         Node *l, *r;
+         split(root, block, l, r);
+         root = merge(merge(l, new Node{block, nullptr, nullptr, block->size, seed}), r);
+      }
+
+   private:
+      //
+      // Node
+      //
+      struct Node
+      {
+         Block        *block;
+         Node         *left, *right;
+         T             max;
+         std::uint32_t prio;
+      };
+
+      //
+      // destroy
+      //
+      static void destroy(Node *node)
+      {
+         if(node)
+         {
+            destroy(node->left);
+            destroy(node->right);
+            delete node;
+         }
+      }
+
+      //
+      // erase
+      //
+      static void erase(Node *&node, Block const *block)
+      {
+         if(!node) return;
+
+         if(node->block == block)
+         {
+            Node *old = node;
+            node = merge(old->left, old->right);
+            delete old;
+            return;
+         }
+
+         erase(Less(block, node->block) ? node->left : node->right, block);
+         update(node);
+      }
+
+      //
+      // find
+      //
+      static Block *find(Node *node, T const &size, T const &min)
+      {
+         if(!node || node->max < size)
+            return nullptr;
+
+         if(node->block->lo < min)
+            return find(node->right, size, min);
+
+         if(Block *block = find(node->left, size, min))
+            return block;
+
+         if(!(node->block->size < size))
+            return node->block;
+
+         return find(node->right, size, min);
+      }
+
+      //
+      // merge
+      //
+      static Node *merge(Node *l, Node *r)
+      {
+         if(!l) return r;
+         if(!r) return l;
+
+         if(l->prio > r->prio)
+         {
+            l->right = merge(l->right, r);
+            update(l);
+            return l;
+         }
+         else
+         {
+            r->left = merge(l, r->left);
+            update(r);
+            return r;
+         }
+      }
+
+      //
+      // split
+      //
+      // Splits node into blocks before block and the rest.
+      //
+      static void split(Node *node, Block const *block, Node *&l, Node *&r)
+      {
+         if(!node)
+            l = r = nullptr;
+         else if(Less(node->block, block))
+            split(node->right, block, node->right, r), l = node, update(node);
+         else
+            split(node->left, block, l, node->left), r = node, update(node);
+      }
+
+      //
+      // update
+      //
+      static void update(Node *node)
+      {
+         node->max = node->block->size;
+         if(node->left  && node->max < node->left->max)  node->max = node->left->max;
+         if(node->right && node->max < node->right->max) node->max = node->right->max;
+      }
+
+      //
+      // Less
+      //
+      // Empty blocks may share an address.
+      //
+      static bool Less(Block const *l, Block const *r)
+      {
+         if(l->lo < r->lo) return true;
+         if(r->lo < l->lo) return false;
+         return std::less<Block const *>()(l, r);
+      }
+
+      Node         *root;
+      std::uint32_t seed;
+   };
+
    //
    // NumberAlloc
    //
+   // Allocations are placed in the lowest unused range that fits.
+   //
    template<typename T>
    class NumberAlloc
    {
@@ -87,7 +269,7 @@ namespace GDCC::Core
       //
       NumberAlloc()
       {
-         new Block(&head);
+         freeLo.insert(new Block(&head));
       }
 
       //
@@ -105,26 +287,23 @@ namespace GDCC::Core
       Block const *alloc(T const &size)
       {
          // Look for an unused allocation.
-         for(auto &iter : *this)
+         if(Block *iter = freeLo.find(size, 0))
          {
-            if(!iter.used)
+            freeLo.erase(iter);
+
+            // Exact size, use as-is.
+            if(iter->size == size)
             {
-               // Exact size, use as-is.
-               if(iter.size == size)
-               {
-                  iter.used = true;
-                  return &iter;
-               }
-               // Bigger, so split the allocation.
-               else if(iter.size > size)
-               {
-                  new Block(&iter, iter.lo, size, true);
-                  iter.lo   += size;
-                  iter.size -= size;
-                  return iter.prev;
-               }
-               // Otherwise, continue searching.
+               iter->used = true;
+               return iter;
             }
+
+            // Bigger, so split the allocation.
+            new Block(iter, iter->lo, size, true);
+            iter->lo   += size;
+            iter->size -= size;
+            freeLo.insert(iter);
+            return iter->prev;
          }
 
          Block &last = back();
@@ -132,6 +311,7 @@ namespace GDCC::Core
          // If last allocation is unused, extend it.
          if(!last.used)
          {
+            freeLo.erase(&last);
             last.hi   = last.lo + size;
             last.size = size;
             last.used = true;
@@ -164,9 +344,13 @@ namespace GDCC::Core
 
          if(prevFree)
          {
+            freeLo.erase(&*prev);
+
             // Both neighbors free.
             if(nextFree)
             {
+               freeLo.erase(&*next);
+
                prev->hi    = next->hi;
                prev->size += iter->size + next->size;
 
@@ -182,12 +366,16 @@ namespace GDCC::Core
 
                delete &*iter;
             }
+
+            freeLo.insert(&*prev);
          }
          else
          {
             // Only next free.
             if(nextFree)
             {
+               freeLo.erase(&*next);
+
                iter->hi    = next->hi;
                iter->size += next->size;
                iter->used  = false;
@@ -200,6 +388,8 @@ namespace GDCC::Core
             {
                iter->used = false;
             }
+
+            freeLo.insert(&*iter);
          }
       }
 
@@ -215,6 +405,8 @@ namespace GDCC::Core
       Block &back() {return *head.prev;}
 
       Block head;
+
+      NumberAllocFree<Block, T> freeLo;
    };
 
    //
@@ -223,6 +415,10 @@ namespace GDCC::Core
    // Number allocator that merges neighboring ranges and can accept
    // explicit address allocations. However, allocations cannot be freed.
    //
+   // Blocks are additionally indexed by address so that finding the block
+   // for an address or the first unused block that fits a request does not
+   // need to walk the whole list.
+   //
    template<typename T>
    class NumberAllocMerge
    {
@@ -242,7 +438,7 @@ namespace GDCC::Core
       //
       NumberAllocMerge()
       {
-         new Block(&head);
+         link(new Block(&head));
       }
 
       //
@@ -259,7 +455,7 @@ namespace GDCC::Core
       //
       T alloc(T const &size)
       {
-         alloc(size, 0);
+         return alloc(size, 0);
       }
 
       //
@@ -268,13 +464,10 @@ namespace GDCC::Core
       T alloc(T const &size, T const &min)
       {
          // Look for an unused allocation.
-         for(auto &block : *this)
+         if(Block *block = freeLo.find(size, min))
          {
-            if(block.used || block.size < size || block.lo < min)
-               continue;
-
-            T addr = block.lo;
-            allocAt(size, addr, &block);
+            T addr = block->lo;
+            allocAt(size, addr, block);
             return addr;
          }
 
@@ -291,11 +484,17 @@ namespace GDCC::Core
 
          if(block.hi < min)
          {
-            allocAt(size, min, new Block(&head, block.hi, size, true));
+            allocAt(size, min, link(new Block(&head, block.hi, size, true)));
             return min;
          }
-         else
-            return (new Block(&head, block.hi, size, true))->lo;
+
+         // Last allocation is used, so extend it.
+         T addr = block.hi;
+         unlink(&block);
+         block.hi    += size;
+         block.size  += size;
+         link(&block);
+         return addr;
       }
 
       //
@@ -303,20 +502,15 @@ namespace GDCC::Core
       //
       void allocAt(T const &size, T const &addr)
       {
-         for(auto &block : *this)
-         {
-            if(block.lo > addr || addr >= block.hi)
-               continue;
-
-            allocAt(size, addr, &block);
-            return;
-         }
+         // Find the block containing addr, if any.
+         auto itr = blockLo.upper_bound(addr);
+         if(itr != blockLo.begin() && addr < (--itr)->second->hi)
+            return allocAt(size, addr, itr->second);
 
          if(back().used)
-            allocAt(size, addr, new Block(&head, head.prev->hi, size, true));
+            allocAt(size, addr, link(new Block(&head, head.prev->hi, size, true)));
          else
             allocAt(size, addr, &back());
-
       }
 
       // begin
@@ -335,6 +529,8 @@ namespace GDCC::Core
       {
          T hi = lo + size;
 
+         unlink(block);
+
          // Possibly extend block forward.
          if(block->hi < hi)
          {
@@ -348,18 +544,20 @@ namespace GDCC::Core
             // Check for splitting off high part.
             if(block->hi > hi)
             {
-               new Block(block, block->lo, hi - block->lo, false);
+               link(new Block(block, block->lo, hi - block->lo, false));
 
                block->lo   = hi;
                block->size = block->hi - block->lo;
 
+               link(block);
                block = block->prev;
+               unlink(block);
             }
 
             // Check for splitting off low part.
             if(block->lo < lo)
             {
-               new Block(block, block->lo, lo - block->lo, false);
+               link(new Block(block, block->lo, lo - block->lo, false));
 
                block->lo   = lo;
                block->size = block->hi - block->lo;
@@ -370,12 +568,13 @@ namespace GDCC::Core
 
          // If there is a gap between this and previous block, fill it.
          if(block->prev != &head && block->prev->hi < block->lo)
-            new Block(block, block->prev->hi, block->lo - block->prev->hi, false);
+            link(new Block(block, block->prev->hi, block->lo - block->prev->hi, false));
 
          // If previous block is used, merge with it.
          if(block->prev != &head && block->prev->used)
          {
             Block *prev = block->prev;
+            unlink(prev);
             prev->hi    = block->hi;
             prev->size += block->size;
             delete block;
@@ -385,28 +584,77 @@ namespace GDCC::Core
          // If block overlaps next block(s), merge with them.
          while(block->next != &head && block->hi > block->next->lo)
          {
+            Block *next = block->next;
+            unlink(next);
+
             // Partial overlap?
-            if(block->hi < block->next->hi)
+            if(block->hi < next->hi)
             {
-               block->next->lo   = block->hi;
-               block->next->size = block->next->hi - block->next->lo;
+               next->lo   = block->hi;
+               next->size = next->hi - next->lo;
+               link(next);
             }
             else
-               delete block->next;
+               delete next;
          }
 
          // If next block is used, merge with it.
          if(block->next != &head && block->next->used)
          {
-            block->hi    = block->next->hi;
-            block->size += block->next->size;
-            delete block->next;
+            Block *next = block->next;
+            unlink(next);
+            block->hi    = next->hi;
+            block->size += next->size;
+            delete next;
          }
+
+         link(block);
       }
 
       Block &back() {return *head.prev;}
 
+      //
+      // link
+      //
+      // Adds block to the indexes.
+      //
+      Block *link(Block *block)
+      {
+         if(!block->used)
+            freeLo.insert(block);
+
+         if(block->lo < block->hi)
+            blockLo.emplace(block->lo, block);
+
+         return block;
+      }
+
+      //
+      // unlink
+      //
+      // Removes block from the indexes. Must be called before changing any
+      // of the block's fields.
+      //
+      void unlink(Block *block)
+      {
+         if(!block->used)
+            freeLo.erase(block);
+
+         if(block->lo < block->hi)
+         {
+            auto itr = blockLo.find(block->lo);
+            if(itr != blockLo.end() && itr->second == block)
+               blockLo.erase(itr);
+         }
+      }
+
       Block head;
+
+      // Unused blocks.
+      NumberAllocFree<Block, T> freeLo;
+
+      // Nonempty blocks by address.
+      std::map<T, Block *> blockLo;
    };
 }
 
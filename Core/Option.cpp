@@ -102,6 +102,22 @@ namespace GDCC::Core
             .setName("sys-source")
             .setGroup("input")
             .setDescS("Adds source file from system directory."),
+      },
+
+      optJobs
+      {
+         nullptr, Option::Base::Info()
+            .setName("jobs").setName('j')
+            .setGroup("input")
+            .setDescS("Sets the number of sources to compile at once.")
+            .setDescL("Sets the number of sources to compile at once. Each "
+               "source is compiled separately and the results are merged in "
+               "command line order, so output does not depend on this "
+               "option. If 0, uses one job per hardware thread.\n"
+               "\n"
+               "Default is 1."),
+
+         1
       }
    {
       list.processLoose = &args;
@@ -18,6 +18,7 @@
 #include "../Option/CStr.hpp"
 #include "../Option/CStrV.hpp"
 #include "../Option/Function.hpp"
+#include "../Option/Int.hpp"
 #include "../Option/Program.hpp"
 
 
@@ -61,6 +62,8 @@ namespace GDCC::Core
 
       Option::CStr       optLibPath;
       SystemSourceOption optSysSource;
+
+      Option::Int<std::size_t> optJobs;
    };
 }
 
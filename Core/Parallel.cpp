@@ -0,0 +1,95 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Parallel job execution.
+//
+//-----------------------------------------------------------------------------
+
+#include "Core/Parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::Core
+{
+   //
+   // GetParallelJobs
+   //
+   // Converts a user-requested job count, where 0 means one per hardware
+   // thread.
+   //
+   std::size_t GetParallelJobs(std::size_t jobs)
+   {
+      if(jobs) return jobs;
+
+      if(std::size_t hw = std::thread::hardware_concurrency())
+         return hw;
+
+      return 1;
+   }
+
+   //
+   // ParallelFor
+   //
+   void ParallelFor(std::size_t jobs, std::size_t count,
+      std::function<void(std::size_t)> const &fn)
+   {
+      jobs = std::min(GetParallelJobs(jobs), count);
+
+      // Single job runs in order on the calling thread.
+      if(jobs <= 1)
+      {
+         for(std::size_t i = 0; i != count; ++i)
+            fn(i);
+
+         return;
+      }
+
+      std::atomic<std::size_t>        next{0};
+      std::vector<std::exception_ptr> errs(count);
+      std::vector<std::thread>        threads;
+
+      auto work = [&]()
+      {
+         for(std::size_t i; (i = next++) < count;)
+         {
+            try {fn(i);}
+            catch(...) {errs[i] = std::current_exception();}
+         }
+      };
+
+      // If a thread cannot be started, continue with those that were.
+      try
+      {
+         threads.reserve(jobs - 1);
+         for(std::size_t i = 1; i != jobs; ++i)
+            threads.emplace_back(work);
+      }
+      catch(std::system_error const &) {}
+
+      work();
+
+      for(auto &thread : threads)
+         thread.join();
+
+      for(auto &err : errs)
+         if(err) std::rethrow_exception(err);
+   }
+}
+
+// EOF
+
@@ -0,0 +1,37 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2024 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Parallel job execution.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__Core__Parallel_H__
+#define GDCC__Core__Parallel_H__
+
+#include "../Core/Types.hpp"
+
+#include <functional>
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::Core
+{
+   std::size_t GetParallelJobs(std::size_t jobs);
+
+   // Calls fn for every index in [0, count) using up to jobs threads. If any
+   // call throws, the exception from the lowest index is rethrown after all
+   // threads have finished.
+   void ParallelFor(std::size_t jobs, std::size_t count,
+      std::function<void(std::size_t)> const &fn);
+}
+
+#endif//GDCC__Core__Parallel_H__
+
@@ -30,9 +30,8 @@ namespace GDCC::Core
    //
    std::string const &GetSystemPath()
    {
-      static std::string path;
-
-      if(path.empty())
+      // Initialized once, so that it may be called from multiple threads.
+      static std::string const path = []() -> std::string
       {
          #ifdef _WIN32
          TCHAR buffer[MAX_PATH+1];
@@ -41,15 +40,16 @@ namespace GDCC::Core
 
          // 0 means failure, size means buffer too small.
          if(len == 0 || len == size)
-            return path;
+            return {};
 
-         path = {buffer, len};
-         Core::PathDirnameEq(path);
-         Core::PathNormalizeEq(path);
+         std::string p{buffer, len};
+         Core::PathDirnameEq(p);
+         Core::PathNormalizeEq(p);
+         return p;
          #else
-         path = "/usr/share/gdcc";
+         return "/usr/share/gdcc";
          #endif
-      }
+      }();
 
       return path;
    }
@@ -13,18 +13,56 @@
 #include "Core/String.hpp"
 
 #include <cctype>
+#include <climits>
 #include <cstring>
+#include <mutex>
+#include <new>
 #include <tuple>
 #include <vector>
 
 
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::Core
+{
+   //
+   // StringTableShard
+   //
+   // One partition of the string table's hash index. Each shard is an open
+   // addressing table of string indexes that grows to keep its load at or
+   // below one half. Access to a shard must be guarded by its mutex.
+   //
+   class StringTableShard
+   {
+   public:
+      template<typename Match>
+      std::size_t find(std::size_t hash, std::size_t len, Match const &match) const;
+
+      void insert(std::size_t hash, std::size_t idx);
+
+      std::vector<std::unique_ptr<char[]>> alloc;
+      std::mutex                           mutex;
+
+   private:
+      void grow();
+
+      std::vector<std::size_t> table;
+      std::size_t              count = 0;
+   };
+}
+
+
 //----------------------------------------------------------------------------|
 // Static Prototypes                                                          |
 //
 
 namespace GDCC::Core
 {
-   static std::vector<GDCC::Core::StringData> &StringTable();
+   static std::size_t StringTableInit();
+
+   static StringTableShard &StringTableShardFor(std::size_t hash);
 }
 
 
@@ -34,8 +72,17 @@ namespace GDCC::Core
 
 namespace GDCC::Core
 {
-   static constexpr std::size_t StringTableHashC = 1024;
-   static std::size_t StringTableHash[StringTableHashC];
+   static constexpr std::size_t StringTableChunkC = std::size_t(1) << 14;
+   static constexpr std::size_t StringTableChunkN = String::DataMask + 1;
+   static std::atomic<StringData *> StringTableChunk[StringTableChunkC];
+
+   static constexpr std::size_t StringTableShardB = 6;
+   static constexpr std::size_t StringTableShardC = std::size_t(1) << StringTableShardB;
+
+   static std::atomic<std::size_t> StringTableCount{0};
+
+   // Ensure the built-in strings exist even if no string is ever looked up.
+   [[maybe_unused]] static std::size_t const StringTableInitC = StringTableInit();
 }
 
 
@@ -45,8 +92,7 @@ namespace GDCC::Core
 
 namespace GDCC::Core
 {
-   std::size_t       String::DataC = StringTable().size();
-   StringData const *String::DataV = StringTable().data();
+   std::atomic<StringData *> const *String::DataV = StringTableChunk;
 }
 
 
@@ -57,29 +103,198 @@ namespace GDCC::Core
 namespace GDCC::Core
 {
    //
-   // StringTable
+   // StringTableMix
+   //
+   // StrHash leaves the high bits poorly distributed for short strings, so
+   // spread it before selecting shards and slots.
+   //
+   static std::size_t StringTableMix(std::size_t hash)
+   {
+      hash ^= hash >> 15;
+      hash *= static_cast<std::size_t>(0x9E3779B97F4A7C15ull);
+      hash ^= hash >> 13;
+
+      return hash;
+   }
+
+   //
+   // StringTableShardFor
+   //
+   static StringTableShard &StringTableShardFor(std::size_t hash)
+   {
+      // Function local so that it is usable from other static initializers.
+      static StringTableShard shards[StringTableShardC];
+
+      constexpr std::size_t shift = sizeof(std::size_t) * CHAR_BIT - StringTableShardB;
+      return shards[StringTableMix(hash) >> shift];
+   }
+
+   //
+   // StringTableSlot
+   //
+   // Returns storage for a new entry, allocating its chunk if needed.
+   //
+   static StringData *StringTableSlot(std::size_t idx)
+   {
+      std::size_t chunkIdx = idx / StringTableChunkN;
+
+      if(chunkIdx >= StringTableChunkC)
+         throw std::bad_alloc();
+
+      auto       &chunkRef = StringTableChunk[chunkIdx];
+      StringData *chunk    = chunkRef.load(std::memory_order_acquire);
+
+      if(!chunk)
+      {
+         auto chunkNew = static_cast<StringData *>(
+            ::operator new(sizeof(StringData) * StringTableChunkN));
+
+         if(chunkRef.compare_exchange_strong(chunk, chunkNew,
+            std::memory_order_acq_rel, std::memory_order_acquire))
+            chunk = chunkNew;
+         else
+            ::operator delete(chunkNew);
+      }
+
+      return chunk + idx % StringTableChunkN;
+   }
+
+   //
+   // StringTableAdd
+   //
+   // The caller must hold the lock for shard.
+   //
+   static String StringTableAdd(StringTableShard &shard, char const *str,
+      std::size_t len, std::size_t hash)
+   {
+      std::size_t idx = StringTableCount.fetch_add(1, std::memory_order_relaxed);
+
+      new(StringTableSlot(idx)) StringData(str, len, hash, idx);
+      shard.insert(hash, idx);
+
+      return String(idx);
+   }
+
+   //
+   // StringTableAdd
+   //
+   static String StringTableAdd(StringTableShard &shard,
+      std::unique_ptr<char[]> &&str, std::size_t len, std::size_t hash)
+   {
+      shard.alloc.emplace_back(std::move(str));
+      return StringTableAdd(shard, shard.alloc.back().get(), len, hash);
+   }
+
+   //
+   // StringTableGet
+   //
+   // Finds an existing entry accepted by match or adds the string returned by
+   // make, as a single operation on the shard.
+   //
+   template<typename Match, typename Make>
+   static String StringTableGet(std::size_t hash, std::size_t len,
+      Match const &match, Make const &make)
+   {
+      StringTableInit();
+
+      auto &shard = StringTableShardFor(hash);
+      std::lock_guard<std::mutex> lock{shard.mutex};
+
+      if(std::size_t idx = shard.find(hash, len, match))
+         return String(idx);
+
+      return StringTableAdd(shard, make(), len, hash);
+   }
+
+   //
+   // StringTableInit
+   //
+   // Adds the built-in strings. Safe to call repeatedly, and from other
+   // static initializers.
    //
-   static std::vector<StringData> &StringTable()
+   static std::size_t StringTableInit()
    {
-      static std::vector<StringData> table
+      static std::size_t const count = []()
       {
-         StringData(STRNULL),
-         StringData("__VA_ARGS__", STR___VA_ARGS__),
+         std::size_t idx = 0;
+
+         auto add = [&idx](auto const &...args)
+         {
+            auto data = new(StringTableSlot(idx)) StringData(args...);
+
+            // STRNULL is not indexed, matching lookups of empty strings.
+            if(idx != STRNULL)
+               StringTableShardFor(data->getHash()).insert(data->getHash(), idx);
+
+            ++idx;
+         };
+
+         add(STRNULL);
+         add("__VA_ARGS__", STR___VA_ARGS__);
          #define GDCC_Core_StringList(name, str) \
-            StringData(str, STR_##name),
+            add(str, STR_##name);
          #include "Core/StringList.hpp"
-      };
 
-      return table;
+         StringTableCount.store(idx, std::memory_order_release);
+
+         return idx;
+      }();
+
+      return count;
    }
 
    //
-   // StringTableAlloc
+   // StringTableShard::find
    //
-   static std::vector<std::unique_ptr<char[]>> &StringTableAlloc()
+   template<typename Match>
+   std::size_t StringTableShard::find(std::size_t hash, std::size_t len,
+      Match const &match) const
    {
-      static std::vector<std::unique_ptr<char[]>> table;
-      return table;
+      if(table.empty()) return STRNULL;
+
+      std::size_t mask = table.size() - 1;
+      for(std::size_t i = StringTableMix(hash);; ++i)
+      {
+         std::size_t idx = table[i & mask];
+         if(!idx) return STRNULL;
+
+         auto const &entry = String::GetData(idx);
+         if(entry.getHash() == hash && entry.size() == len && match(entry))
+            return idx;
+      }
+   }
+
+   //
+   // StringTableShard::grow
+   //
+   void StringTableShard::grow()
+   {
+      std::vector<std::size_t> old(table.size() ? table.size() * 2 : 64, STRNULL);
+      std::swap(table, old);
+
+      std::size_t mask = table.size() - 1;
+      for(std::size_t idx : old) if(idx)
+      {
+         std::size_t i = StringTableMix(String::GetData(idx).getHash());
+         while(table[i & mask]) ++i;
+         table[i & mask] = idx;
+      }
+   }
+
+   //
+   // StringTableShard::insert
+   //
+   void StringTableShard::insert(std::size_t hash, std::size_t idx)
+   {
+      if((count + 1) * 2 > table.size())
+         grow();
+
+      std::size_t mask = table.size() - 1;
+      std::size_t i    = StringTableMix(hash);
+      while(table[i & mask]) ++i;
+      table[i & mask] = idx;
+
+      ++count;
    }
 }
 
@@ -98,7 +313,6 @@ namespace GDCC::Core
       len     {0},
       len0    {0},
       hash    {0},
-      next    {0},
       idxLower{0},
       len16   {0},
       len32   {0}
@@ -109,17 +323,15 @@ namespace GDCC::Core
    // StringData constructor
    //
    StringData::StringData(char const *str_, std::size_t len_,
-      std::size_t hash_, std::size_t idx) :
+      std::size_t hash_, std::size_t) :
       str     {str_},
       len     {len_},
       len0    {std::strlen(str_)},
       hash    {hash_},
-      next    {StringTableHash[hash % StringTableHashC]},
       idxLower{0},
       len16   {0},
       len32   {0}
    {
-      StringTableHash[hash % StringTableHashC] = idx;
    }
 
    //
@@ -140,18 +352,22 @@ namespace GDCC::Core
    //
    std::size_t StringData::size16() const
    {
+      std::size_t n = len16.load(std::memory_order_relaxed);
+
       // Compute length, if needed.
-      if(!len16)
+      if(!n)
       {
          for(auto itr = str, e = itr + len; itr != e;)
          {
             char32_t c;
             std::tie(c, itr) = Str8To32(itr, e);
-            len16 += c > 0xFFFF ? 2 : 1;
+            n += c > 0xFFFF ? 2 : 1;
          }
+
+         len16.store(n, std::memory_order_relaxed);
       }
 
-      return len16;
+      return n;
    }
 
    //
@@ -159,22 +375,18 @@ namespace GDCC::Core
    //
    std::size_t StringData::size32() const
    {
+      std::size_t n = len32.load(std::memory_order_relaxed);
+
       // Compute length, if needed.
-      if(!len32)
+      if(!n)
       {
-         for(auto itr = str, e = itr + len; itr != e; ++len32)
+         for(auto itr = str, e = itr + len; itr != e; ++n)
             std::tie(std::ignore, itr) = Str8To32(itr, e);
-      }
 
-      return len32;
-   }
+         len32.store(n, std::memory_order_relaxed);
+      }
 
-   //
-   // StringData::GetFirst
-   //
-   std::size_t StringData::GetFirst(std::size_t hash)
-   {
-      return StringTableHash[hash % StringTableHashC];
+      return n;
    }
 
    //
@@ -182,44 +394,40 @@ namespace GDCC::Core
    //
    String String::getLower() const
    {
-      if(!StringTable()[idx].idxLower)
-      {
-         StringData &data = StringTable()[idx];
+      StringData const &data = GetData(idx);
 
-         // Check if string is already lowercase.
-         if(data.isLower())
-            return String(data.idxLower = idx);
+      if(std::size_t idxLower = data.idxLower.load(std::memory_order_relaxed))
+         return String(idxLower);
 
-         // TODO: Unicode support.
+      // Check if string is already lowercase.
+      if(data.isLower())
+      {
+         data.idxLower.store(idx, std::memory_order_relaxed);
+         return *this;
+      }
 
-         // Calculate new length.
-         std::size_t len = data.len;
+      // TODO: Unicode support.
 
-         // Convert case into buffer.
-         std::unique_ptr<char[]> str{new char[data.len + 1]};
-         char *out = str.get();
-         for(char c : data)
-            *out++ = std::tolower(c);
-         *out = '\0';
+      // Convert case into buffer.
+      std::unique_ptr<char[]> str{new char[data.len + 1]};
+      char *out = str.get();
+      for(char c : data)
+         *out++ = std::tolower(c);
+      *out = '\0';
 
-         // Calculate new hash.
-         std::size_t hash = StrHash(str.get(), data.len);
+      // Find or add new string.
+      char const *s    = str.get();
+      std::size_t len  = data.len;
+      String      lower = StringTableGet(StrHash(s, len), len,
+         [&](StringData const &entry) {return !std::memcmp(entry.data(), s, len);},
+         [&]() {return std::move(str);});
 
-         // Find or add new string.
-         std::size_t idxLower;
-         if(auto s = Find(str.get(), len, hash))
-            idxLower = s.idx;
-         else
-            idxLower = Add(std::move(str), len, hash).idx;
+      data.idxLower.store(lower.idx, std::memory_order_relaxed);
 
-         // The call to Add might invalidate data's address, so avoid it.
-         StringTable()[idx].idxLower = idxLower;
+      // Also set idxLower's idxLower to itself.
+      GetData(lower.idx).idxLower.store(lower.idx, std::memory_order_relaxed);
 
-         // Also set idxLower's idxLower to itself.
-         StringTable()[idxLower].idxLower = idxLower;
-      }
-
-      return String(StringTable()[idx].idxLower);
+      return lower;
    }
 
    //
@@ -227,14 +435,12 @@ namespace GDCC::Core
    //
    String String::Add(char const *str, std::size_t len, std::size_t hash)
    {
-      std::size_t idx = StringTable().size();
+      StringTableInit();
 
-      StringTable().emplace_back(str, len, hash, idx);
+      auto &shard = StringTableShardFor(hash);
+      std::lock_guard<std::mutex> lock{shard.mutex};
 
-      String::DataC = StringTable().size();
-      String::DataV = StringTable().data();
-
-      return String(idx);
+      return StringTableAdd(shard, str, len, hash);
    }
 
    //
@@ -243,8 +449,12 @@ namespace GDCC::Core
    String String::Add(std::unique_ptr<char[]> &&str, std::size_t len,
       std::size_t hash)
    {
-      StringTableAlloc().emplace_back(std::move(str));
-      return Add(StringTableAlloc().back().get(), len, hash);
+      StringTableInit();
+
+      auto &shard = StringTableShardFor(hash);
+      std::lock_guard<std::mutex> lock{shard.mutex};
+
+      return StringTableAdd(shard, std::move(str), len, hash);
    }
 
    //
@@ -275,17 +485,13 @@ namespace GDCC::Core
    {
       if(!str) return STRNULL;
 
-      for(auto idx = StringTableHash[hash % StringTableHashC]; idx;)
-      {
-         auto const &entry = StringTable()[idx];
+      StringTableInit();
 
-         if(entry.hash == hash && entry.len == len && !std::memcmp(entry.str, str, len))
-            return String(idx);
-
-         idx = entry.next;
-      }
+      auto &shard = StringTableShardFor(hash);
+      std::lock_guard<std::mutex> lock{shard.mutex};
 
-      return STRNULL;
+      return String(shard.find(hash, len, [&](StringData const &entry)
+         {return !std::memcmp(entry.data(), str, len);}));
    }
 
    //
@@ -316,9 +522,21 @@ namespace GDCC::Core
    {
       if(!str) return STRNULL;
 
-      if(auto s = Find(str, len, hash)) return s;
+      return StringTableGet(hash, len,
+         [&](StringData const &entry) {return !std::memcmp(entry.data(), str, len);},
+         [&]() {return StrDup(str, len);});
+   }
 
-      return Add(StrDup(str, len), len, hash);
+   //
+   // String::GetDataC
+   //
+   // Entries below the returned count may still be under construction by
+   // other threads, so this is only meaningful when no strings are being
+   // added concurrently.
+   //
+   std::size_t String::GetDataC()
+   {
+      return StringTableCount.load(std::memory_order_acquire);
    }
 
    //
@@ -340,24 +558,20 @@ namespace GDCC::Core
       std::size_t len  = l.size() + rl;
       std::size_t hash = StrHash(r, rl, l.getHash());
 
-      for(auto idx = StringData::GetFirst(hash); idx;)
-      {
-         auto const &entry = String::GetDataV()[idx];
-
-         if(entry.getHash() == hash && entry.size() == len &&
-            !std::memcmp(entry.data(),            l.data(), l.size()) &&
-            !std::memcmp(entry.data() + l.size(), r,        rl))
-            return String(idx);
-
-         idx = entry.getNext();
-      }
-
-      std::unique_ptr<char[]> newstr{new char[len + 1]};
-      std::memcpy(newstr.get(),            l.data(), l.size());
-      std::memcpy(newstr.get() + l.size(), r,        rl);
-      newstr[len] = '\0';
-
-      return String::Add(std::move(newstr), len, hash);
+      return StringTableGet(hash, len,
+         [&](StringData const &entry)
+         {
+            return !std::memcmp(entry.data(),            l.data(), l.size()) &&
+                   !std::memcmp(entry.data() + l.size(), r,        rl);
+         },
+         [&]()
+         {
+            std::unique_ptr<char[]> newstr{new char[len + 1]};
+            std::memcpy(newstr.get(),            l.data(), l.size());
+            std::memcpy(newstr.get() + l.size(), r,        rl);
+            newstr[len] = '\0';
+            return newstr;
+         });
    }
 
    //
@@ -368,24 +582,20 @@ namespace GDCC::Core
       std::size_t len  = l.size() + r.size();
       std::size_t hash = StrHash(r.data(), r.size(), l.getHash());
 
-      for(auto idx = StringData::GetFirst(hash); idx;)
-      {
-         auto const &entry = String::GetDataV()[idx];
-
-         if(entry.getHash() == hash && entry.size() == len &&
-            !std::memcmp(entry.data(),            l.data(), l.size()) &&
-            !std::memcmp(entry.data() + l.size(), r.data(), r.size()))
-            return String(idx);
-
-         idx = entry.getNext();
-      }
-
-      std::unique_ptr<char[]> newstr{new char[len + 1]};
-      std::memcpy(newstr.get(),            l.data(), l.size());
-      std::memcpy(newstr.get() + l.size(), r.data(), r.size());
-      newstr[len] = '\0';
-
-      return String::Add(std::move(newstr), len, hash);
+      return StringTableGet(hash, len,
+         [&](StringData const &entry)
+         {
+            return !std::memcmp(entry.data(),            l.data(), l.size()) &&
+                   !std::memcmp(entry.data() + l.size(), r.data(), r.size());
+         },
+         [&]()
+         {
+            std::unique_ptr<char[]> newstr{new char[len + 1]};
+            std::memcpy(newstr.get(),            l.data(), l.size());
+            std::memcpy(newstr.get() + l.size(), r.data(), r.size());
+            newstr[len] = '\0';
+            return newstr;
+         });
    }
 
    //
@@ -17,6 +17,7 @@
 
 #include "../Option/StrUtil.hpp"
 
+#include <atomic>
 #include <ostream>
 
 
@@ -41,6 +42,9 @@ namespace GDCC::Core
    //
    // StringData
    //
+   // Entries are never moved once added to the table, so references to them
+   // remain valid for the life of the program.
+   //
    class StringData
    {
    public:
@@ -69,8 +73,6 @@ namespace GDCC::Core
 
       std::size_t getHash() const {return hash;}
 
-      std::size_t getNext() const {return next;}
-
       std::size_t size() const {return len;}
       std::size_t size0() const {return len0;}
       std::size_t size16() const;
@@ -79,8 +81,6 @@ namespace GDCC::Core
 
       friend class String;
 
-      static std::size_t GetFirst(std::size_t hash);
-
    private:
       bool isLower() const;
 
@@ -88,17 +88,21 @@ namespace GDCC::Core
       std::size_t const len;
       std::size_t const len0;
       std::size_t const hash;
-      std::size_t const next;
 
-      mutable std::size_t idxLower;
+      // Lazily computed, possibly by several threads at once. All writers
+      // store the same value, so relaxed ordering suffices.
+      mutable std::atomic<std::size_t> idxLower;
 
-      mutable std::size_t len16;
-      mutable std::size_t len32;
+      mutable std::atomic<std::size_t> len16;
+      mutable std::atomic<std::size_t> len32;
    };
 
    //
    // String
    //
+   // Strings are interned in a global table which may be safely accessed by
+   // multiple threads. A String's index is never reused or changed.
+   //
    class String
    {
    public:
@@ -118,30 +122,30 @@ namespace GDCC::Core
       constexpr operator StringIndex () const
          {return idx < STRMAX ? static_cast<StringIndex>(idx) : STRNULL;}
 
-      char const &operator [] (std::size_t i) const {return DataV[idx][i];}
+      char const &operator [] (std::size_t i) const {return GetData(idx)[i];}
 
       String &operator = (StringIndex idx_) {idx = idx_; return *this;}
 
-      char const &back() const {return DataV[idx].back();}
+      char const &back() const {return GetData(idx).back();}
 
-      char const *begin() const {return DataV[idx].begin();}
+      char const *begin() const {return GetData(idx).begin();}
 
-      char const *data() const {return DataV[idx].data();}
+      char const *data() const {return GetData(idx).data();}
 
-      bool empty() const {return DataV[idx].empty();}
+      bool empty() const {return GetData(idx).empty();}
 
-      char const *end() const {return DataV[idx].end();}
+      char const *end() const {return GetData(idx).end();}
 
-      char const &front() const {return DataV[idx].front();}
+      char const &front() const {return GetData(idx).front();}
 
-      std::size_t getHash() const {return DataV[idx].getHash();}
+      std::size_t getHash() const {return GetData(idx).getHash();}
 
       String getLower() const;
 
-      std::size_t size() const {return DataV[idx].size();}
-      std::size_t size0() const {return DataV[idx].size0();}
-      std::size_t size16() const {return DataV[idx].size16();}
-      std::size_t size32() const {return DataV[idx].size32();}
+      std::size_t size() const {return GetData(idx).size();}
+      std::size_t size0() const {return GetData(idx).size0();}
+      std::size_t size16() const {return GetData(idx).size16();}
+      std::size_t size32() const {return GetData(idx).size32();}
 
 
       // String must not already exist in table.
@@ -157,15 +161,21 @@ namespace GDCC::Core
       static String Get(char const *str, std::size_t len);
       static String Get(char const *str, std::size_t len, std::size_t hash);
 
-      static std::size_t       GetDataC() {return DataC;}
-      static StringData const *GetDataV() {return DataV;}
+      // Entries are stored in fixed-size chunks so that adding strings never
+      // moves existing ones.
+      static constexpr std::size_t DataBits = 12;
+      static constexpr std::size_t DataMask = (std::size_t(1) << DataBits) - 1;
+
+      static StringData const &GetData(std::size_t idx)
+         {return DataV[idx >> DataBits].load(std::memory_order_relaxed)[idx & DataMask];}
+
+      static std::size_t GetDataC();
 
    private:
       std::size_t idx;
 
 
-      static std::size_t       DataC;
-      static StringData const *DataV;
+      static std::atomic<StringData *> const *DataV;
    };
 }
 
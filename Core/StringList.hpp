@@ -46,6 +46,7 @@ GDCC_Core_StringList(__hub_arr, "__hub_arr")
 GDCC_Core_StringList(__hub_ars, "__hub_ars")
 GDCC_Core_StringList(__hub_reg, "__hub_reg")
 GDCC_Core_StringList(__indexof, "__indexof")
+GDCC_Core_StringList(__inline, "__inline")
 GDCC_Core_StringList(__label, "__label")
 GDCC_Core_StringList(__loc, "__loc")
 GDCC_Core_StringList(__loc_arr, "__loc_arr")
@@ -60,6 +61,7 @@ GDCC_Core_StringList(__mod_ars, "__mod_ars")
 GDCC_Core_StringList(__mod_reg, "__mod_reg")
 GDCC_Core_StringList(__no_init, "__no_init")
 GDCC_Core_StringList(__no_init_delay, "__no_init_delay")
+GDCC_Core_StringList(__noinline, "__noinline")
 GDCC_Core_StringList(__offsetof, "__offsetof")
 GDCC_Core_StringList(__operator, "__operator")
 GDCC_Core_StringList(__optional_args, "__optional_args")
@@ -363,6 +365,8 @@ GDCC_Core_StringList(import, "import")
 GDCC_Core_StringList(include, "include")
 GDCC_Core_StringList(initi, "initi")
 GDCC_Core_StringList(inline, "inline")
+GDCC_Core_StringList(inlineAlways, "inlineAlways")
+GDCC_Core_StringList(inlineNever, "inlineNever")
 GDCC_Core_StringList(int, "int")
 GDCC_Core_StringList(kill, "kill")
 GDCC_Core_StringList(label, "label")
@@ -385,6 +389,7 @@ GDCC_Core_StringList(multiDef, "multiDef")
 GDCC_Core_StringList(net, "net")
 GDCC_Core_StringList(no_init, "no_init")
 GDCC_Core_StringList(no_init_delay, "no_init_delay")
+GDCC_Core_StringList(noinline, "noinline")
 GDCC_Core_StringList(noreturn, "noreturn")
 GDCC_Core_StringList(nocompact, "nocompact")
 GDCC_Core_StringList(nowadauthor, "nowadauthor")
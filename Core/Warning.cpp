@@ -125,21 +125,25 @@ namespace GDCC::Core
    //
    // Warning::warnPre
    //
-   void Warning::warnPre(Origin pos) const
+   void Warning::warnPre(std::ostringstream &msg, Origin pos) const
    {
-      std::cerr << "WARNING: ";
-      if(pos.file) std::cerr << pos << ": ";
+      msg << "WARNING: ";
+      if(pos.file) msg << pos << ": ";
    }
 
    //
    // Warning::warnPro
    //
-   void Warning::warnPro() const
+   void Warning::warnPro(std::ostringstream &msg) const
    {
       if(opt)
-         std::cerr << " [" << opt << ']';
+         msg << " [" << opt << ']';
 
-      std::cerr << std::endl;
+      msg << '\n';
+
+      // Write the whole message at once, so that warnings from concurrent
+      // jobs do not interleave.
+      std::cerr << msg.str() << std::flush;
    }
 
    //
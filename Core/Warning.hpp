@@ -18,6 +18,7 @@
 #include "../Option/Bool.hpp"
 
 #include <iostream>
+#include <sstream>
 
 
 //----------------------------------------------------------------------------|
@@ -85,9 +86,10 @@ namespace GDCC::Core
          if(WarnError)
             Error(pos, args..., " [--warn-error]");
 
-         warnPre(pos);
-         ((std::cerr << args), ...);
-         warnPro();
+         std::ostringstream msg;
+         warnPre(msg, pos);
+         ((msg << args), ...);
+         warnPro(msg);
       }
 
 
@@ -96,8 +98,8 @@ namespace GDCC::Core
       static bool &WarnError;
 
    private:
-      void warnPre(Origin pos) const;
-      void warnPro() const;
+      void warnPre(std::ostringstream &msg, Origin pos) const;
+      void warnPro(std::ostringstream &msg) const;
 
 
       Warning const *base;
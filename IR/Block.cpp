@@ -27,6 +27,24 @@
 
 namespace GDCC::IR
 {
+   //
+   // Block move assignment
+   //
+   Block &Block::operator = (Block &&block)
+   {
+      if(&block == this) return *this;
+
+      // Statements must be destroyed before their arena.
+      clear();
+
+      argSize = block.argSize;
+      labs    = std::move(block.labs);
+      head    = std::move(block.head);
+      arena   = std::move(block.arena);
+
+      return *this;
+   }
+
    //
    // Block::addLabel
    //
@@ -54,7 +72,7 @@ namespace GDCC::IR
       head.args = std::move(args);
       head.labs = Core::Array<Core::String>(Core::Move, labs.begin(), labs.end());
       labs.clear();
-      new Statement(std::move(head), link, code);
+      new(arena) Statement(std::move(head), link, code);
       return *this;
    }
 
@@ -181,7 +199,7 @@ namespace GDCC::IR
    {
       in >> out.labs >> out.head;
       for(auto count = GetIR<Block::size_type>(in); count--;)
-         in >> *new Statement(&out.head);
+         in >> *new(out.arena) Statement(&out.head);
       return in;
    }
 }
@@ -51,9 +51,9 @@ namespace GDCC::IR
 
       Block() = default;
       Block(Block &&) = default;
-      ~Block() {while(head.next != &head) delete head.next;}
+      ~Block() {clear();}
 
-      Block &operator = (Block &&) = default;
+      Block &operator = (Block &&block);
 
       // addLabel
       Block &addLabel(Core::String lab);
@@ -85,6 +85,9 @@ namespace GDCC::IR
             iterator begin()       {return static_cast<      iterator>(head.next);}
       const_iterator begin() const {return static_cast<const_iterator>(head.next);}
 
+      // clear
+      void clear() {while(head.next != &head) delete head.next;}
+
       // empty
       bool empty() const {return head.next == &head;}
 
@@ -183,6 +186,7 @@ namespace GDCC::IR
       Core::FastU               argSize = 0;
       std::vector<Core::String> labs;
       Statement                 head;
+      StatementArena            arena;
    };
 }
 
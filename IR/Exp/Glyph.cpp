@@ -31,13 +31,27 @@ namespace GDCC::IR
    {
    }
 
+   //
+   // Exp_Glyph::v_getType
+   //
+   // Glyph data is only looked up here, not created, so that expressions may
+   // be evaluated from several threads at once.
+   //
+   Type Exp_Glyph::v_getType() const
+   {
+      if(auto data = glyph.findData())
+         return data->type;
+
+      return Type();
+   }
+
    //
    // Exp_Glyph::v_getValue
    //
    Value Exp_Glyph::v_getValue() const
    {
-      if(auto value = glyph.getData().value)
-         return value->getValue();
+      if(auto data = glyph.findData(); data && data->value)
+         return data->value->getValue();
 
       Core::ErrorUndef(pos, "glyph", static_cast<Core::String>(glyph));
    }
@@ -47,8 +61,8 @@ namespace GDCC::IR
    //
    bool Exp_Glyph::v_isValue() const
    {
-      auto &glyphData = glyph.getData();
-      return glyphData.value && glyphData.value->isValue();
+      auto glyphData = glyph.findData();
+      return glyphData && glyphData->value && glyphData->value->isValue();
    }
 
    //
@@ -47,7 +47,7 @@ namespace GDCC::IR
          Super{pos_}, glyph{glyph_} {}
       explicit Exp_Glyph(IArchive &in);
 
-      virtual Type v_getType() const {return glyph.getData().type;}
+      virtual Type v_getType() const;
 
       virtual Value v_getValue() const;
 
@@ -12,6 +12,108 @@
 
 #include "IR/Exp/Value.hpp"
 
+#include "Core/Option.hpp"
+
+#include "Option/Bool.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::IR
+{
+   //
+   // --ir-exp-intern
+   //
+   static Option::Bool ExpIntern
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("ir-exp-intern")
+         .setGroup("codegen")
+         .setDescS("Shares identical fixed-point literal expressions.")
+         .setDescL("Shares identical fixed-point literal expressions. Literals "
+            "with the same value, type, and origin are created as a single "
+            "node.\n\n"
+            "Only fixed-point literals are shared, and only with others from "
+            "the same source position, since the origin is kept for "
+            "diagnostics and written to IR. This reduces peak memory but "
+            "costs some time, so it is disabled by default."),
+
+      false
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::IR
+{
+   //
+   // ExpValueShard
+   //
+   // One partition of the interned literal table. Entries do not hold
+   // references, so nodes remove themselves when destroyed.
+   //
+   class ExpValueShard
+   {
+   public:
+      std::mutex                                              mutex;
+      std::unordered_multimap<std::size_t, Exp_Value const *> table;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::IR
+{
+   static constexpr std::size_t ExpValueShardC = 16;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::IR
+{
+   //
+   // ExpValueHash
+   //
+   static std::size_t ExpValueHash(Value_Fixed const &value, Core::Origin pos)
+   {
+      std::size_t hash = std::hash<Core::String>()(pos.file);
+
+      hash = hash * 31 + pos.line;
+      hash = hash * 31 + pos.col;
+      hash = hash * 31 + value.vtype.bitsI;
+      hash = hash * 31 + value.vtype.bitsF;
+      hash = hash * 31 + value.vtype.bitsS * 2 + value.vtype.satur;
+      hash = hash * 31 + mpz_get_ui(value.value.get_mpz_t());
+      hash = hash * 31 + mpz_sgn(value.value.get_mpz_t());
+
+      return hash;
+   }
+
+   //
+   // ExpValueShardFor
+   //
+   static ExpValueShard &ExpValueShardFor(std::size_t hash)
+   {
+      // Never destroyed, as nodes may outlive static destruction.
+      static auto *shards = new ExpValueShard[ExpValueShardC];
+      return shards[(hash ^ (hash >> 16)) % ExpValueShardC];
+   }
+}
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -26,6 +128,63 @@ namespace GDCC::IR
    {
    }
 
+   //
+   // Exp_Value destructor
+   //
+   Exp_Value::~Exp_Value()
+   {
+      if(!intern) return;
+
+      auto &shard = ExpValueShardFor(internHash);
+      std::lock_guard<std::mutex> lock{shard.mutex};
+
+      for(auto [itr, end] = shard.table.equal_range(internHash); itr != end; ++itr)
+      {
+         if(itr->second == this)
+            {shard.table.erase(itr); break;}
+      }
+   }
+
+   //
+   // Exp_Value::Intern
+   //
+   // Returns an existing node for value and pos, or else exp. If exp is
+   // null, a new node is made from value.
+   //
+   template<typename V>
+   Exp::CRef Exp_Value::Intern(V &&value, Core::Origin pos, Exp_Value *exp)
+   {
+      if(!ExpIntern || value.v != ValueBase::Fixed)
+      {
+         if(!exp) exp = new Exp_Value(std::forward<V>(value), pos);
+         return static_cast<Exp::CRef>(exp);
+      }
+
+      auto const &fixed = value.vFixed;
+      std::size_t hash  = ExpValueHash(fixed, pos);
+
+      auto &shard = ExpValueShardFor(hash);
+      std::lock_guard<std::mutex> lock{shard.mutex};
+
+      // Nodes being destroyed by another thread may still be in the table.
+      for(auto [itr, end] = shard.table.equal_range(hash); itr != end; ++itr)
+      {
+         auto e = itr->second;
+         if(e->pos == pos && e->value.vFixed.vtype == fixed.vtype &&
+            e->value.vFixed.value == fixed.value)
+         {
+            if(auto ref = TryRef(e)) return static_cast<Exp::CRef>(ref);
+         }
+      }
+
+      if(!exp) exp = new Exp_Value(std::forward<V>(value), pos);
+      exp->internHash = hash;
+      exp->intern     = true;
+      shard.table.emplace(hash, exp);
+
+      return static_cast<Exp::CRef>(exp);
+   }
+
    //
    // Exp_Value::v_putIR
    //
@@ -39,7 +198,7 @@ namespace GDCC::IR
    //
    Exp::CRef ExpCreate_Value(Value const &value, Core::Origin pos)
    {
-      return static_cast<Exp::CRef>(new Exp_Value(value, pos));
+      return Exp_Value::Intern(value, pos, nullptr);
    }
 
    //
@@ -47,7 +206,7 @@ namespace GDCC::IR
    //
    Exp::CRef ExpCreate_Value(Value &&value, Core::Origin pos)
    {
-      return static_cast<Exp::CRef>(new Exp_Value(std::move(value), pos));
+      return Exp_Value::Intern(std::move(value), pos, nullptr);
    }
 
    //
@@ -55,7 +214,14 @@ namespace GDCC::IR
    //
    Exp::CRef ExpGetIR_Value(IArchive &in)
    {
-      return static_cast<Exp::CRef>(new Exp_Value(in));
+      auto exp = new Exp_Value(in);
+      auto ref = static_cast<Exp::CRef>(exp);
+
+      // Only share nodes whose stored type matches their value.
+      if(!(exp->type == exp->value.getType()))
+         return ref;
+
+      return Exp_Value::Intern(exp->value, exp->pos, exp);
    }
 }
 
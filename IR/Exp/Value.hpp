@@ -49,6 +49,7 @@ namespace GDCC::IR
       Exp_Value(Value &&value_, Core::Origin pos_) :
          Super{pos_}, type{value_.getType()}, value{std::move(value_)} {}
       explicit Exp_Value(IArchive &in);
+      virtual ~Exp_Value();
 
       virtual Type v_getType() const {return type;}
 
@@ -57,6 +58,13 @@ namespace GDCC::IR
       virtual bool v_isValue() const {return true;}
 
       virtual OArchive &v_putIR(OArchive &out) const;
+
+   private:
+      template<typename V>
+      static Exp::CRef Intern(V &&value, Core::Origin pos, Exp_Value *exp);
+
+      std::size_t internHash;
+      bool        intern = false;
    };
 }
 
@@ -0,0 +1,630 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2025 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Intermediary Representation control and data flow analysis.
+//
+//-----------------------------------------------------------------------------
+
+#include "IR/Flow.hpp"
+
+#include "IR/Block.hpp"
+#include "IR/Exp/Glyph.hpp"
+
+#include <algorithm>
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::IR
+{
+   //
+   // FindLabel
+   //
+   static std::size_t FindLabel(
+      std::unordered_map<Core::String, std::size_t> const &labels, Arg const &arg)
+   {
+      auto exp = arg.a == ArgBase::Lit
+         ? dynamic_cast<Exp_Glyph const *>(&*arg.aLit.value) : nullptr;
+
+      if(!exp) return Flow::None;
+
+      auto lab = labels.find(exp->glyph);
+      return lab == labels.end() ? Flow::None : lab->second;
+   }
+
+   //
+   // HasFlowEdges
+   //
+   // Returns true if the code can go anywhere other than the next statement.
+   //
+   static bool HasFlowEdges(Code code)
+   {
+      switch(code.base)
+      {
+      case CodeBase::Jcnd_Nil:
+      case CodeBase::Jcnd_Tab:
+      case CodeBase::Jcnd_Tru:
+      case CodeBase::Jdyn:
+      case CodeBase::Jfar_Pro:
+      case CodeBase::Jfar_Set:
+      case CodeBase::Jfar_Sta:
+      case CodeBase::Jump:
+      case CodeBase::Retn:
+         return true;
+
+      default:
+         return false;
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::IR
+{
+   //
+   // FlowSet::merge
+   //
+   bool FlowSet::merge(std::size_t dst, FlowSet const &src, std::size_t srcRow)
+   {
+      bool changed = false;
+      auto       d = row(dst);
+      auto const s = src.row(srcRow);
+      for(std::size_t i = 0; i != size; ++i)
+      {
+         auto v = d[i] | s[i];
+         if(v != d[i]) d[i] = v, changed = true;
+      }
+      return changed;
+   }
+
+   //
+   // Flow constructor
+   //
+   Flow::Flow(Block &block_) :
+      block{block_},
+      varN {0},
+
+      exact     {true},
+      validDom  {false},
+      validGraph{false},
+      validLive {false},
+      validReach{false}
+   {
+   }
+
+   //
+   // Flow::buildAccess
+   //
+   // Queries accesses of edited statements and marks their nodes.
+   //
+   void Flow::buildAccess()
+   {
+      for(std::size_t i = 0, e = stmnts.size(); i != e; ++i)
+      {
+         if(!accessDirty[i]) continue;
+
+         accessDirty[i] = false;
+         accessStmnt[i].clear();
+         if(access) access(i, accessStmnt[i]);
+
+         liveDirty[stmntNode[i]] = true;
+      }
+   }
+
+   //
+   // Flow::buildDom
+   //
+   // Iterative dominators over reverse postorder.
+   //
+   void Flow::buildDom()
+   {
+      buildGraph();
+
+      if(validDom) return;
+
+      std::size_t nodeN = nodes.size();
+
+      idom.assign(nodeN, None);
+      order.assign(nodeN, None);
+
+      if(!nodeN) {validDom = true; return;}
+
+      // Find postorder.
+      std::vector<std::size_t>                         post;
+      std::vector<std::pair<std::size_t, std::size_t>> stack;
+      std::vector<bool>                                seen(nodeN);
+
+      stack.emplace_back(0, 0);
+      seen[0] = true;
+      while(!stack.empty())
+      {
+         auto &top  = stack.back();
+         auto &succ = nodes[top.first].succ;
+
+         if(top.second == succ.size())
+         {
+            post.push_back(top.first);
+            stack.pop_back();
+            continue;
+         }
+
+         auto next = succ[top.second++];
+         if(next != nodeN && !seen[next])
+         {
+            seen[next] = true;
+            stack.emplace_back(next, 0);
+         }
+      }
+
+      std::reverse(post.begin(), post.end());
+      for(std::size_t i = 0; i != post.size(); ++i)
+         order[post[i]] = i;
+
+      auto intersect = [&](std::size_t l, std::size_t r)
+      {
+         while(l != r)
+         {
+            while(order[l] > order[r]) l = idom[l];
+            while(order[r] > order[l]) r = idom[r];
+         }
+         return l;
+      };
+
+      idom[0] = 0;
+      for(bool changed = true; changed;)
+      {
+         changed = false;
+
+         for(std::size_t i = 1; i != post.size(); ++i)
+         {
+            auto n   = post[i];
+            auto dom = None;
+
+            for(auto pred : nodes[n].pred)
+            {
+               if(idom[pred] == None) continue;
+               dom = dom == None ? pred : intersect(pred, dom);
+            }
+
+            if(idom[n] != dom)
+               idom[n] = dom, changed = true;
+         }
+      }
+
+      validDom = true;
+   }
+
+   //
+   // Flow::buildGraph
+   //
+   void Flow::buildGraph()
+   {
+      if(validGraph) return;
+
+      exact = true;
+      nodes.clear();
+      stmnts.clear();
+      stmntIdx.clear();
+
+      std::unordered_map<Core::String, std::size_t> labels;
+
+      for(auto &st : block)
+      {
+         for(auto const &lab : st.labs)
+            labels.emplace(lab, stmnts.size());
+
+         stmntIdx.emplace(&st, stmnts.size());
+         stmnts.push_back(&st);
+      }
+
+      std::size_t stmntN = stmnts.size();
+
+      // Far jumps resume at the labels given to Jfar_Set.
+      std::vector<std::size_t> jfars;
+      bool                     jfarDyn = false;
+      for(auto st : stmnts)
+      {
+         if(st->code == CodeBase::Jfar_Set)
+         {
+            auto lab = FindLabel(labels, st->args[0]);
+            if(lab == None) jfarDyn = true;
+            else            jfars.push_back(lab);
+         }
+      }
+
+      // Find statement successors. Index stmntN is the exit.
+      std::vector<std::vector<std::size_t>> succs{stmntN};
+      stmntJump.assign(stmntN, false);
+
+      for(std::size_t i = 0; i != stmntN; ++i)
+      {
+         auto st = stmnts[i];
+
+         bool        dyn  = false;
+         bool        fall = true;
+         std::size_t jump = st->args.size();
+         std::size_t step = 1;
+
+         switch(st->code.base)
+         {
+         case CodeBase::Jcnd_Nil:
+         case CodeBase::Jcnd_Tru: jump = 1; break;
+         case CodeBase::Jcnd_Tab: jump = 2; step = 2; break;
+         case CodeBase::Jdyn:     fall = false; dyn = true; break;
+         case CodeBase::Jump:     fall = false; jump = 0; break;
+         case CodeBase::Retn:     fall = false; succs[i].push_back(stmntN); break;
+
+         // Calls and far jumps can resume at any Jfar_Set label.
+         case CodeBase::Jfar_Pro:
+         case CodeBase::Jfar_Sta:
+            succs[i].insert(succs[i].end(), jfars.begin(), jfars.end());
+            dyn = jfarDyn;
+         case CodeBase::Jfar_Set:
+            jump = 0; step = st->args.size();
+            break;
+
+         default: break;
+         }
+
+         for(; jump < st->args.size(); jump += step)
+         {
+            auto lab = FindLabel(labels, st->args[jump]);
+            if(lab == None) dyn = true;
+            else            succs[i].push_back(lab);
+         }
+
+         // Unknown target, so assume any label or the exit.
+         if(dyn)
+         {
+            exact = false;
+            for(auto const &lab : labels)
+               succs[i].push_back(lab.second);
+            succs[i].push_back(stmntN);
+         }
+
+         if(fall)
+            succs[i].push_back(i + 1);
+
+         stmntJump[i] = HasFlowEdges(st->code);
+      }
+
+      // Find leaders.
+      std::vector<bool> lead(stmntN + 1);
+      if(stmntN) lead[0] = true;
+      for(std::size_t i = 0; i != stmntN; ++i)
+      {
+         if(!stmnts[i]->labs.empty())
+            lead[i] = true;
+
+         if(succs[i].size() != 1 || succs[i][0] != i + 1)
+         {
+            lead[i + 1] = true;
+            for(auto succ : succs[i])
+               lead[succ] = true;
+         }
+      }
+
+      // Form nodes.
+      stmntNode.assign(stmntN, None);
+      for(std::size_t i = 0; i != stmntN; ++i)
+      {
+         if(lead[i])
+            nodes.push_back({i, i, {}, {}});
+
+         nodes.back().end = i + 1;
+         stmntNode[i] = nodes.size() - 1;
+      }
+
+      std::size_t nodeN = nodes.size();
+      for(std::size_t n = 0; n != nodeN; ++n)
+      {
+         auto &succ = nodes[n].succ;
+
+         for(auto s : succs[nodes[n].end - 1])
+            succ.push_back(s == stmntN ? nodeN : stmntNode[s]);
+
+         std::sort(succ.begin(), succ.end());
+         succ.erase(std::unique(succ.begin(), succ.end()), succ.end());
+
+         for(auto s : succ)
+            if(s != nodeN) nodes[s].pred.push_back(n);
+      }
+
+      accessStmnt.resize(stmntN);
+      accessDirty.assign(stmntN, true);
+      liveDirty.assign(nodeN, true);
+
+      validGraph = true;
+      validDom   = false;
+      validLive  = false;
+      validReach = false;
+   }
+
+   //
+   // Flow::buildLive
+   //
+   void Flow::buildLive()
+   {
+      buildGraph();
+
+      if(validLive) return;
+
+      buildAccess();
+
+      std::size_t nodeN  = nodes.size();
+      std::size_t stmntN = stmnts.size();
+
+      if(liveGen.data.size() != nodeN * ((varN + 63) / 64))
+      {
+         liveGen.reset(nodeN, varN);
+         liveKill.reset(nodeN, varN);
+         liveDirty.assign(nodeN, true);
+      }
+
+      // Summarize edited nodes.
+      for(std::size_t n = 0; n != nodeN; ++n)
+      {
+         if(!liveDirty[n]) continue;
+
+         liveDirty[n] = false;
+         std::fill_n(liveGen.row(n), liveGen.size, 0);
+         std::fill_n(liveKill.row(n), liveKill.size, 0);
+
+         for(std::size_t i = nodes[n].end; i-- != nodes[n].beg;)
+         {
+            auto const &acc = accessStmnt[i];
+
+            for(auto v : acc.def) liveGen.unset(n, v), liveKill.set(n, v);
+            for(auto v : acc.mod) liveGen.set(n, v);
+            for(auto v : acc.use) liveGen.set(n, v);
+         }
+      }
+
+      // Solve over nodes.
+      FlowSet nodeIn{nodeN, varN}, nodeOut{nodeN, varN}, in{1, varN};
+      for(bool changed = true; changed;)
+      {
+         changed = false;
+
+         for(std::size_t n = nodeN; n--;)
+         {
+            for(auto succ : nodes[n].succ)
+               if(succ != nodeN) nodeOut.merge(n, nodeIn, succ);
+
+            auto gen  = liveGen.row(n);
+            auto kill = liveKill.row(n);
+            auto out  = nodeOut.row(n);
+            for(std::size_t w = 0; w != in.size; ++w)
+               in.data[w] = gen[w] | (out[w] & ~kill[w]);
+
+            changed |= nodeIn.merge(n, in, 0);
+         }
+      }
+
+      // Expand to statements.
+      liveIn.reset(stmntN, varN);
+      liveOut.reset(stmntN, varN);
+      for(std::size_t n = 0; n != nodeN; ++n)
+      {
+         std::copy_n(nodeOut.row(n), in.size, in.row(0));
+
+         for(std::size_t i = nodes[n].end; i-- != nodes[n].beg;)
+         {
+            auto const &acc = accessStmnt[i];
+
+            liveOut.merge(i, in, 0);
+            for(auto v : acc.def) in.unset(0, v);
+            for(auto v : acc.mod) in.set(0, v);
+            for(auto v : acc.use) in.set(0, v);
+            liveIn.merge(i, in, 0);
+         }
+      }
+
+      validLive = true;
+   }
+
+   //
+   // Flow::buildReach
+   //
+   void Flow::buildReach()
+   {
+      buildGraph();
+
+      if(validReach) return;
+
+      buildAccess();
+
+      std::size_t nodeN  = nodes.size();
+      std::size_t stmntN = stmnts.size();
+
+      // Number definitions. Each variable also has one for its entry value.
+      reachDef.clear();
+      reachVar.assign(varN, {});
+      for(std::size_t i = 0; i != stmntN; ++i)
+      {
+         for(auto v : accessStmnt[i].def)
+            reachVar[v].push_back(reachDef.size()), reachDef.push_back(i);
+         for(auto v : accessStmnt[i].mod)
+            reachVar[v].push_back(reachDef.size()), reachDef.push_back(i);
+      }
+
+      std::size_t entry = reachDef.size();
+      for(std::size_t v = 0; v != varN; ++v)
+         reachVar[v].push_back(reachDef.size()), reachDef.push_back(stmntN);
+
+      std::size_t defN = reachDef.size();
+
+      // Summarize nodes.
+      reachGen.reset(nodeN, defN);
+      reachKill.reset(nodeN, defN);
+      for(std::size_t n = 0, id = 0; n != nodeN; ++n)
+      {
+         for(std::size_t i = nodes[n].beg; i != nodes[n].end; ++i)
+         {
+            for(auto v : accessStmnt[i].def)
+            {
+               for(auto d : reachVar[v])
+                  reachGen.unset(n, d), reachKill.set(n, d);
+               reachGen.set(n, id++);
+            }
+
+            for(std::size_t k = accessStmnt[i].mod.size(); k--;)
+               reachGen.set(n, id++);
+         }
+      }
+
+      // Solve over nodes.
+      FlowSet out{nodeN, defN}, next{1, defN};
+      reachIn.reset(nodeN, defN);
+      for(std::size_t d = entry; nodeN && d != defN; ++d)
+         reachIn.set(0, d);
+
+      for(bool changed = true; changed;)
+      {
+         changed = false;
+
+         for(std::size_t n = 0; n != nodeN; ++n)
+         {
+            for(auto pred : nodes[n].pred)
+               reachIn.merge(n, out, pred);
+
+            auto gen  = reachGen.row(n);
+            auto kill = reachKill.row(n);
+            auto in   = reachIn.row(n);
+            for(std::size_t w = 0; w != next.size; ++w)
+               next.data[w] = gen[w] | (in[w] & ~kill[w]);
+
+            changed |= out.merge(n, next, 0);
+         }
+      }
+
+      validReach = true;
+   }
+
+   //
+   // Flow::getIDom
+   //
+   std::size_t Flow::getIDom(std::size_t node)
+   {
+      buildDom();
+      return node ? idom[node] : None;
+   }
+
+   //
+   // Flow::getReachingDefs
+   //
+   void Flow::getReachingDefs(std::size_t stmnt, std::size_t var,
+      std::vector<std::size_t> &out)
+   {
+      buildReach();
+
+      auto n = stmntNode[stmnt];
+
+      // Look for a write earlier in the same node.
+      for(auto i = stmnt; i-- != nodes[n].beg;)
+      {
+         auto const &acc = accessStmnt[i];
+
+         if(std::find(acc.def.begin(), acc.def.end(), var) != acc.def.end())
+            return out.push_back(i);
+
+         if(std::find(acc.mod.begin(), acc.mod.end(), var) != acc.mod.end())
+            out.push_back(i);
+      }
+
+      for(auto d : reachVar[var])
+         if(reachIn.test(n, d)) out.push_back(reachDef[d]);
+   }
+
+   //
+   // Flow::getStmntIndex
+   //
+   std::size_t Flow::getStmntIndex(Statement const *stmnt)
+   {
+      buildGraph();
+
+      auto itr = stmntIdx.find(stmnt);
+      return itr == stmntIdx.end() ? None : itr->second;
+   }
+
+   //
+   // Flow::invalidate
+   //
+   void Flow::invalidate()
+   {
+      validGraph = false;
+   }
+
+   //
+   // Flow::invalidate
+   //
+   // Edits that cannot change edges only require the statement's accesses
+   // to be found again. Liveness summaries of other nodes are kept.
+   //
+   void Flow::invalidate(Statement const *stmnt)
+   {
+      if(!validGraph) return;
+
+      auto itr = stmntIdx.find(stmnt);
+      if(itr == stmntIdx.end() || stmntJump[itr->second] || HasFlowEdges(stmnt->code))
+         return invalidate();
+
+      accessDirty[itr->second] = true;
+      validLive  = false;
+      validReach = false;
+   }
+
+   //
+   // Flow::isDominator
+   //
+   bool Flow::isDominator(std::size_t dom, std::size_t node)
+   {
+      buildDom();
+
+      if(order[node] == None)
+         return false;
+
+      for(;;)
+      {
+         if(node == dom) return true;
+         if(node == 0)   return false;
+         node = idom[node];
+      }
+   }
+
+   //
+   // Flow::isReachable
+   //
+   bool Flow::isReachable(std::size_t node)
+   {
+      buildDom();
+      return order[node] != None;
+   }
+
+   //
+   // Flow::setAccess
+   //
+   void Flow::setAccess(std::size_t vars, AccessFn fn)
+   {
+      access = std::move(fn);
+      varN   = vars;
+
+      accessDirty.assign(accessDirty.size(), true);
+      validLive  = false;
+      validReach = false;
+   }
+}
+
+// EOF
+
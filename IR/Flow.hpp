@@ -0,0 +1,212 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2025 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Intermediary Representation control and data flow analysis.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__IR__Flow_H__
+#define GDCC__IR__Flow_H__
+
+#include "../IR/Types.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::IR
+{
+   //
+   // FlowSet
+   //
+   // A table of fixed size bit sets.
+   //
+   class FlowSet
+   {
+   public:
+      FlowSet() : size{0} {}
+      FlowSet(std::size_t rows, std::size_t bits) {reset(rows, bits);}
+
+      // Sets dst |= src and returns true if dst changed.
+      bool merge(std::size_t dst, FlowSet const &src, std::size_t srcRow);
+
+      void reset(std::size_t rows, std::size_t bits)
+         {size = (bits + 63) / 64; data.assign(rows * size, 0);}
+
+            std::uint64_t *row(std::size_t r)       {return &data[r * size];}
+      std::uint64_t const *row(std::size_t r) const {return &data[r * size];}
+
+      void set(std::size_t r, std::size_t bit)
+         {data[r * size + bit / 64] |= std::uint64_t(1) << bit % 64;}
+
+      bool test(std::size_t r, std::size_t bit) const
+         {return data[r * size + bit / 64] >> bit % 64 & 1;}
+
+      void unset(std::size_t r, std::size_t bit)
+         {data[r * size + bit / 64] &= ~(std::uint64_t(1) << bit % 64);}
+
+      std::size_t                size;
+      std::vector<std::uint64_t> data;
+   };
+
+   //
+   // FlowAccess
+   //
+   // Variable accesses of a single statement, as reported by a client of
+   // Flow. Variables are numbered by the client.
+   //
+   class FlowAccess
+   {
+   public:
+      void clear() {def.clear(); mod.clear(); use.clear();}
+
+      std::vector<std::size_t> def; // Completely written.
+      std::vector<std::size_t> mod; // Partially written.
+      std::vector<std::size_t> use; // Read.
+   };
+
+   //
+   // Flow
+   //
+   // Basic blocks and edges of a Block, along with analyses over them.
+   // Results are computed on first request and kept until invalidated.
+   //
+   // Edges follow labels, Jump, Jcnd_*, Retn and far jumps. Branches with
+   // targets that cannot be resolved are assumed to go to any label or
+   // leave the function.
+   //
+   class Flow
+   {
+   public:
+      using AccessFn = std::function<void(std::size_t stmnt, FlowAccess &access)>;
+
+      //
+      // Node
+      //
+      class Node
+      {
+      public:
+         std::size_t              beg, end; // Statement range.
+         std::vector<std::size_t> pred;
+         std::vector<std::size_t> succ;     // Exit is getNodeCount().
+      };
+
+      static constexpr std::size_t None = static_cast<std::size_t>(-1);
+
+
+      explicit Flow(Block &block);
+
+      // getAccess
+      // Returns the variables accessed by a statement.
+      FlowAccess const &getAccess(std::size_t stmnt)
+         {buildGraph(); buildAccess(); return accessStmnt[stmnt];}
+
+      // getIDom
+      // Returns None for the entry and unreachable nodes.
+      std::size_t getIDom(std::size_t node);
+
+      Node const &getNode(std::size_t node) {buildGraph(); return nodes[node];}
+
+      std::size_t getNodeCount() {buildGraph(); return nodes.size();}
+
+      std::size_t getNodeOf(std::size_t stmnt) {buildGraph(); return stmntNode[stmnt];}
+
+      // getReachingDefs
+      // Appends the statements whose writes to var can reach stmnt. The
+      // value on entry to the function is getStmntCount().
+      void getReachingDefs(std::size_t stmnt, std::size_t var,
+         std::vector<std::size_t> &out);
+
+      Statement *getStmnt(std::size_t stmnt) {buildGraph(); return stmnts[stmnt];}
+
+      std::size_t getStmntCount() {buildGraph(); return stmnts.size();}
+
+      std::size_t getStmntIndex(Statement const *stmnt);
+
+      std::size_t getVarCount() const {return varN;}
+
+      // invalidate
+      // Must be called after statements or labels are added or removed.
+      void invalidate();
+
+      // invalidate
+      // Must be called after a statement's code or arguments are changed.
+      void invalidate(Statement const *stmnt);
+
+      // isDominator
+      // Returns true if every path from the entry to node passes dom.
+      bool isDominator(std::size_t dom, std::size_t node);
+
+      // isExact
+      // Returns false if any branch target had to be assumed.
+      bool isExact() {buildGraph(); return exact;}
+
+      bool isLiveIn(std::size_t stmnt, std::size_t var)
+         {buildLive(); return liveIn.test(stmnt, var);}
+
+      bool isLiveOut(std::size_t stmnt, std::size_t var)
+         {buildLive(); return liveOut.test(stmnt, var);}
+
+      bool isReachable(std::size_t node);
+
+      // Per-statement liveness, indexed by statement then variable.
+      FlowSet const &getLiveIn() {buildLive(); return liveIn;}
+      FlowSet const &getLiveOut() {buildLive(); return liveOut;}
+
+      // setAccess
+      // Sets the variables to analyze and how to find accesses to them.
+      void setAccess(std::size_t vars, AccessFn fn);
+
+   private:
+      void buildAccess();
+      void buildDom();
+      void buildGraph();
+      void buildLive();
+      void buildReach();
+
+      Block &block;
+
+      AccessFn                access;
+      std::vector<FlowAccess> accessStmnt;
+      std::vector<bool>       accessDirty;
+      std::size_t             varN;
+
+      std::vector<Node>                                  nodes;
+      std::vector<Statement *>                           stmnts;
+      std::vector<bool>                                  stmntJump;
+      std::vector<std::size_t>                           stmntNode;
+      std::unordered_map<Statement const *, std::size_t> stmntIdx;
+
+      std::vector<std::size_t> idom;
+      std::vector<std::size_t> order; // Reverse postorder position.
+
+      FlowSet           liveIn, liveOut;
+      FlowSet           liveGen, liveKill;
+      std::vector<bool> liveDirty; // Per node.
+
+      std::vector<std::size_t>              reachDef;  // Statement of each def.
+      std::vector<std::vector<std::size_t>> reachVar;  // Defs of each var.
+      FlowSet                               reachIn;
+      FlowSet                               reachGen, reachKill;
+
+      bool exact      : 1;
+      bool validDom   : 1;
+      bool validGraph : 1;
+      bool validLive  : 1;
+      bool validReach : 1;
+   };
+}
+
+#endif//GDCC__IR__Flow_H__
+
@@ -47,8 +47,10 @@ namespace GDCC::IR
       valueInt{0},
       valueStr{Core::STRNULL},
 
-      alloc   {false},
-      defin   {false}
+      alloc       {false},
+      defin       {false},
+      inlineAlways{false},
+      inlineNever {false}
    {
    }
 
@@ -98,7 +100,9 @@ namespace GDCC::IR
          << in.valueInt
          << in.valueStr
          << in.alloc
-         << in.defin;
+         << in.defin
+         << in.inlineAlways
+         << in.inlineNever;
    }
 
    //
@@ -123,6 +127,9 @@ namespace GDCC::IR
       out.alloc = GetIR<bool>(in);
       out.defin = GetIR<bool>(in);
 
+      out.inlineAlways = GetIR<bool>(in);
+      out.inlineNever  = GetIR<bool>(in);
+
       return in;
    }
 }
@@ -61,8 +61,10 @@ namespace GDCC::IR
       Core::FastU  valueInt;
       Core::String valueStr;
 
-      bool         alloc    : 1;
-      bool         defin    : 1;
+      bool         alloc        : 1;
+      bool         defin        : 1;
+      bool         inlineAlways : 1;
+      bool         inlineNever  : 1;
    };
 }
 
@@ -17,6 +17,7 @@
 #include "Target/Addr.hpp"
 #include "Target/CallType.hpp"
 
+#include <climits>
 #include <cstring>
 
 
@@ -139,12 +140,30 @@ namespace GDCC::IR
    Core::Integ IArchive::getInteg()
    {
       bool sign = getBool();
-      Core::Integ out = 0;
+
+      // Accumulate natively while the value is sure to fit.
+      unsigned long outL = 0;
 
       unsigned char c;
       while(((c = in.get()) & 0x80) && in)
-         out <<= 7, out += (c & 0x7F);
-      out <<= 7, out += c;
+      {
+         outL = (outL << 7) + (c & 0x7F);
+
+         if(outL >> (sizeof(long) * CHAR_BIT - 8))
+            break;
+      }
+
+      Core::Integ out;
+
+      if(c & 0x80 && in)
+      {
+         out = outL;
+         while(((c = in.get()) & 0x80) && in)
+            out <<= 7, out += (c & 0x7F);
+         out <<= 7, out += c;
+      }
+      else
+         out = (outL << 7) + c;
 
       if(sign) out = -out;
       return out;
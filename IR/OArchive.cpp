@@ -17,6 +17,9 @@
 #include "Target/Addr.hpp"
 #include "Target/CallType.hpp"
 
+#include <climits>
+#include <iterator>
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -28,7 +31,8 @@ namespace GDCC::IR
    // OArchive constructor
    //
    OArchive::OArchive(std::ostream &out_) :
-      strUse{Core::Size, Core::String::GetDataC(), false},
+      strIdx(Core::String::GetDataC(), 0),
+      strTab{Core::STRNULL},
       out{out_}
    {
    }
@@ -38,9 +42,7 @@ namespace GDCC::IR
    //
    OArchive &OArchive::operator << (Core::String in)
    {
-      auto idx = static_cast<std::size_t>(in);
-      strUse[idx] = true;
-      putU(idx);
+      putU(getStrIdx(static_cast<std::size_t>(in)));
 
       return *this;
    }
@@ -50,9 +52,7 @@ namespace GDCC::IR
    //
    OArchive &OArchive::operator << (Core::StringIndex in)
    {
-      auto idx = static_cast<std::size_t>(in);
-      strUse[idx] = true;
-      putU(idx);
+      putU(getStrIdx(static_cast<std::size_t>(in)));
 
       return *this;
    }
@@ -95,6 +95,30 @@ namespace GDCC::IR
       Core::Error({}, "invalid enum GDCC::Target::CallType");
    }
 
+   //
+   // OArchive::getStrIdx
+   //
+   // Strings are renumbered in order of first use, so that the output does
+   // not depend on the order in which strings were interned. STRNULL always
+   // keeps index 0.
+   //
+   std::size_t OArchive::getStrIdx(std::size_t idx)
+   {
+      if(idx >= strIdx.size())
+         strIdx.resize(Core::String::GetDataC(), 0);
+
+      if(idx == Core::STRNULL) return 0;
+
+      auto &local = strIdx[idx];
+      if(!local)
+      {
+         strTab.push_back(idx);
+         local = strTab.size();
+      }
+
+      return local - 1;
+   }
+
    //
    // OArchive::putHead
    //
@@ -113,6 +137,21 @@ namespace GDCC::IR
       if(sign == 0) {out.put(0); return;}
       if(sign < 0) in = -in;
 
+      // Values that fit in a long are encoded without shifting in.
+      if(mpz_fits_ulong_p(in.get_mpz_t()))
+      {
+         char buf[(sizeof(long) * CHAR_BIT + 6) / 7];
+         char *ptr = std::end(buf);
+
+         unsigned long inL = in.get_ui();
+         *--ptr = static_cast<char>(inL & 0x7F);
+         while((inL >>= 7))
+            *--ptr = static_cast<char>(inL & 0x7F) | 0x80;
+
+         out.write(ptr, std::end(buf) - ptr);
+         return;
+      }
+
       std::size_t len = (mpz_size(in.get_mpz_t()) * sizeof(mp_limb_t) * CHAR_BIT + 6) / 7 + 1;
       std::unique_ptr<char[]> buf{new char[len]};
       char *ptr = &buf[len];
@@ -138,20 +177,13 @@ namespace GDCC::IR
    //
    void OArchive::putStrTab()
    {
-      putU(strUse.size());
+      putU(strTab.size());
 
-      auto str = Core::String::GetDataV();
-      for(auto &use : strUse)
+      for(auto idx : strTab)
       {
-         if(use)
-         {
-            putU(str->size());
-            out.write(str->data(), str->size());
-         }
-         else
-            out.put(0);
-
-         ++str;
+         auto const &str = Core::String::GetData(idx);
+         putU(str.size());
+         out.write(str.data(), str.size());
       }
    }
 
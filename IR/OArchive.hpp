@@ -82,6 +82,8 @@ namespace GDCC::IR
 
       void putRatio(Core::Ratio const &in);
 
+      std::size_t getStrIdx(std::size_t idx);
+
       void putStrTab();
 
       template<typename T>
@@ -97,7 +99,9 @@ namespace GDCC::IR
          out.write(ptr, (buf + len) - ptr);
       }
 
-      Core::Array<bool> strUse;
+      // Archive-local string numbers, assigned in order of first use.
+      std::vector<std::size_t> strIdx; // global -> local + 1
+      std::vector<std::size_t> strTab; // local -> global
 
       std::ostream &out;
    };
@@ -19,6 +19,8 @@
 #include "Core/Exception.hpp"
 #include "Core/Warning.hpp"
 
+#include <algorithm>
+
 
 //----------------------------------------------------------------------------|
 // Options                                                                    |
@@ -51,6 +53,15 @@ namespace GDCC::IR
 
 namespace GDCC::IR
 {
+   //
+   // EraseTable
+   //
+   template<typename T>
+   static void EraseTable(Program::Table<T> &table, Core::String glyph)
+   {
+      table.erase(glyph);
+   }
+
    //
    // FindTable
    //
@@ -126,6 +137,83 @@ namespace GDCC::IR
    {
    }
 
+   //
+   // Program::eraseDJump
+   //
+   void Program::eraseDJump(Core::String glyph)
+   {
+      EraseTable(tableDJump, glyph);
+   }
+
+   //
+   // Program::eraseFunction
+   //
+   void Program::eraseFunction(Core::String glyph)
+   {
+      EraseTable(tableFunction, glyph);
+   }
+
+   //
+   // Program::eraseObject
+   //
+   void Program::eraseObject(Core::String glyph)
+   {
+      if(auto obj = findObject(glyph))
+      {
+         auto itr = tableObjectBySpace.find(obj->space);
+         if(itr != tableObjectBySpace.end())
+            itr->second.erase(glyph);
+      }
+
+      EraseTable(tableObject, glyph);
+   }
+
+   //
+   // Program::eraseSpaceGblArr
+   //
+   void Program::eraseSpaceGblArr(Core::String glyph)
+   {
+      EraseTable(tableSpaceGblArs, glyph);
+   }
+
+   //
+   // Program::eraseSpaceHubArr
+   //
+   void Program::eraseSpaceHubArr(Core::String glyph)
+   {
+      EraseTable(tableSpaceHubArs, glyph);
+   }
+
+   //
+   // Program::eraseSpaceModArr
+   //
+   void Program::eraseSpaceModArr(Core::String glyph)
+   {
+      EraseTable(tableSpaceModArs, glyph);
+   }
+
+   //
+   // Program::eraseStrEnt
+   //
+   void Program::eraseStrEnt(Core::String glyph)
+   {
+      auto itr = tableStrEnt.find(glyph);
+      if(itr == tableStrEnt.end())
+         return;
+
+      indexStrEntByValue();
+
+      auto idx = tableStrEntIndexed.find(&itr->second);
+      if(idx != tableStrEntIndexed.end())
+      {
+         auto &bucket = tableStrEntByValue[idx->second];
+         bucket.erase(std::find(bucket.begin(), bucket.end(), &itr->second));
+         tableStrEntIndexed.erase(idx);
+      }
+
+      tableStrEnt.erase(itr);
+   }
+
    //
    // Program::findDJump
    //
@@ -235,10 +323,10 @@ namespace GDCC::IR
    //
    StrEnt *Program::findStrEntVal(Core::String value)
    {
-      for(auto &itr : tableStrEnt)
+      for(auto str : rangeStrEntByValue(value))
       {
-         if(itr.second.valueStr == value && itr.second.alias && itr.second.defin)
-            return &itr.second;
+         if(str->alias && str->defin)
+            return str;
       }
 
       return nullptr;
@@ -389,7 +477,35 @@ namespace GDCC::IR
    //
    StrEnt &Program::getStrEnt(Core::String glyph)
    {
-      return GetTable(tableStrEnt, glyph, glyph);
+      // The caller may set valueStr.
+      auto &str = GetTable(tableStrEnt, glyph, glyph);
+      tableStrEntPending.push_back(&str);
+      return str;
+   }
+
+   //
+   // Program::indexStrEntByValue
+   //
+   void Program::indexStrEntByValue()
+   {
+      for(auto str : tableStrEntPending)
+      {
+         auto idx = tableStrEntIndexed.find(str);
+         if(idx == tableStrEntIndexed.end())
+            idx = tableStrEntIndexed.emplace(str, str->valueStr).first;
+         else if(idx->second != str->valueStr)
+         {
+            auto &bucket = tableStrEntByValue[idx->second];
+            bucket.erase(std::find(bucket.begin(), bucket.end(), str));
+            idx->second = str->valueStr;
+         }
+         else
+            continue;
+
+         tableStrEntByValue[str->valueStr].push_back(str);
+      }
+
+      tableStrEntPending.clear();
    }
 
    //
@@ -511,6 +627,8 @@ namespace GDCC::IR
    //
    void Program::mergeStrEnt(StrEnt &out, StrEnt &&in)
    {
+      tableStrEntPending.push_back(&out);
+
       if(!out.defin)
          out = std::move(in);
       else if(in.defin && !out.multiDef && !in.multiDef)
@@ -690,6 +808,20 @@ namespace GDCC::IR
       return {itr->second.end(), itr->second.end()};
    }
 
+   //
+   // Program::rangeStrEntByValue
+   //
+   Core::Range<StrEnt *const *> Program::rangeStrEntByValue(Core::String value)
+   {
+      indexStrEntByValue();
+
+      auto itr = tableStrEntByValue.find(value);
+      if(itr == tableStrEntByValue.end())
+         return {nullptr, nullptr};
+
+      return {itr->second.data(), itr->second.data() + itr->second.size()};
+   }
+
    //
    // Program::sizeDJump
    //
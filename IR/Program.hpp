@@ -25,6 +25,7 @@
 #include "../Core/Range.hpp"
 
 #include <unordered_map>
+#include <vector>
 
 
 //----------------------------------------------------------------------------|
@@ -58,6 +59,14 @@ namespace GDCC::IR
       Program &operator = (Program const &) = delete;
       Program &operator = (Program &&) = delete;
 
+      void eraseDJump      (Core::String glyph);
+      void eraseFunction   (Core::String glyph);
+      void eraseObject     (Core::String glyph);
+      void eraseSpaceGblArr(Core::String glyph);
+      void eraseSpaceHubArr(Core::String glyph);
+      void eraseSpaceModArr(Core::String glyph);
+      void eraseStrEnt     (Core::String glyph);
+
       DJump     *findDJump      (Core::String glyph);
       Function  *findFunction   (Core::String glyph);
       GlyphData *findGlyphData  (Core::String glyph);
@@ -120,6 +129,8 @@ namespace GDCC::IR
 
       TableCRange<Object const *> rangeObjectBySpace(AddrSpace as) const;
 
+      Core::Range<StrEnt *const *> rangeStrEntByValue(Core::String value);
+
       std::size_t sizeDJump()       const;
       std::size_t sizeFunction()    const;
       std::size_t sizeGlyphData()   const;
@@ -137,6 +148,8 @@ namespace GDCC::IR
       friend IArchive &operator >> (IArchive &in, Program &out);
 
    private:
+      void indexStrEntByValue();
+
       Table<DJump>     tableDJump;
       Table<Function>  tableFunction;
       Table<GlyphData> tableGlyphData;
@@ -150,6 +163,13 @@ namespace GDCC::IR
 
       std::unordered_map<AddrSpace, Table<Object const *>> tableObjectBySpace;
 
+      // Index of tableStrEnt by valueStr. Entries from getStrEnt and
+      // mergeStrEnt may still have valueStr changed, so they are queued and
+      // moved to their current bucket on the next lookup.
+      std::unordered_map<Core::String, std::vector<StrEnt *>> tableStrEntByValue;
+      std::unordered_map<StrEnt const *, Core::String>        tableStrEntIndexed;
+      std::vector<StrEnt *>                                   tableStrEntPending;
+
       Space spaceGblReg;
       Space spaceHubReg;
       Space spaceModReg;
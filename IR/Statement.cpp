@@ -16,6 +16,8 @@
 #include "IR/IArchive.hpp"
 #include "IR/OArchive.hpp"
 
+#include <algorithm>
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -23,6 +25,52 @@
 
 namespace GDCC::IR
 {
+   //
+   // StatementArena::alloc
+   //
+   void *StatementArena::alloc()
+   {
+      if(!pool)
+         pool.reset(new Pool);
+
+      Slot *slot;
+
+      if(pool->free)
+      {
+         slot       = pool->free;
+         pool->free = slot->next;
+      }
+      else
+      {
+         if(pool->slabUsed == pool->slabSize)
+         {
+            // Slabs grow with the block, up to a fixed limit.
+            pool->slabSize = pool->slabSize
+               ? std::min<std::size_t>(pool->slabSize * 2, 1024) : 16;
+            pool->slabs.emplace_back(new Slot[pool->slabSize]);
+            pool->slabUsed = 0;
+         }
+
+         slot = &pool->slabs.back()[pool->slabUsed++];
+      }
+
+      slot->pool = pool.get();
+      return slot->data;
+   }
+
+   //
+   // StatementArena::Free
+   //
+   void StatementArena::Free(void *ptr)
+   {
+      if(!ptr) return;
+
+      auto slot = static_cast<Slot *>(ptr);
+
+      slot->next       = slot->pool->free;
+      slot->pool->free = slot;
+   }
+
    //
    // Statement default constructor
    //
@@ -115,6 +163,30 @@ namespace GDCC::IR
       return *this;
    }
 
+   //
+   // Statement::operator new
+   //
+   void *Statement::operator new(std::size_t, StatementArena &arena)
+   {
+      return arena.alloc();
+   }
+
+   //
+   // Statement::operator delete
+   //
+   void Statement::operator delete(void *ptr, StatementArena &)
+   {
+      StatementArena::Free(ptr);
+   }
+
+   //
+   // Statement::operator delete
+   //
+   void Statement::operator delete(void *ptr)
+   {
+      StatementArena::Free(ptr);
+   }
+
    //
    // Statement destructor
    //
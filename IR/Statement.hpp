@@ -18,6 +18,9 @@
 
 #include "../Core/Array.hpp"
 
+#include <memory>
+#include <vector>
+
 
 //----------------------------------------------------------------------------|
 // Types                                                                      |
@@ -40,6 +43,12 @@ namespace GDCC::IR
 
       Statement &operator = (Statement &&stmnt);
 
+      // Statements are allocated from their block's arena, which owns the
+      // memory. Deleting a statement returns its slot to that arena.
+      static void *operator new(std::size_t size, StatementArena &arena);
+      static void operator delete(void *ptr, StatementArena &);
+      static void operator delete(void *ptr);
+
       Core::Origin pos;
 
       Statement *next, *prev;
@@ -48,6 +57,58 @@ namespace GDCC::IR
       Core::Array<Core::String> labs;
       Code                      code;
    };
+
+   //
+   // StatementArena
+   //
+   // Slab storage for the statements of a Block. Freed slots are kept in a
+   // list and reused before new slab space.
+   //
+   class StatementArena
+   {
+   public:
+      StatementArena() = default;
+      StatementArena(StatementArena const &) = delete;
+      StatementArena(StatementArena &&) = default;
+
+      StatementArena &operator = (StatementArena &&) = default;
+
+      void *alloc();
+
+      static void Free(void *ptr);
+
+   private:
+      struct Pool;
+
+      //
+      // Slot
+      //
+      struct Slot
+      {
+         union
+         {
+            alignas(Statement) unsigned char data[sizeof(Statement)];
+            Slot *next; // Next free slot.
+         };
+
+         Pool *pool;
+      };
+
+      //
+      // Pool
+      //
+      // Kept on the heap, so slots can refer to it after the arena moves.
+      //
+      struct Pool
+      {
+         std::vector<std::unique_ptr<Slot[]>> slabs;
+         std::size_t                          slabUsed = 0;
+         std::size_t                          slabSize = 0;
+         Slot                                *free     = nullptr;
+      };
+
+      std::unique_ptr<Pool> pool;
+   };
 }
 
 
@@ -53,14 +53,13 @@ namespace GDCC::IR
          valueInt = allocMin;
 
       // First, check for any strings to alias with.
-      if(alias) for(auto const &itr : prog.rangeStrEnt())
+      if(alias) for(auto itr : prog.rangeStrEntByValue(valueStr))
       {
-         if(&itr == this || itr.alloc || !itr.alias) continue;
-         if(itr.valueStr != valueStr) continue;
-         if(itr.valueInt <  valueInt) continue;
+         if(itr == this || itr->alloc || !itr->alias) continue;
+         if(itr->valueInt < valueInt) continue;
 
          alloc    = false;
-         valueInt = itr.valueInt;
+         valueInt = itr->valueInt;
          return;
       }
 
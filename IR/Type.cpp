@@ -20,6 +20,8 @@
 #include "Target/Addr.hpp"
 #include "Target/CallType.hpp"
 
+#include <climits>
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -116,6 +118,51 @@ namespace GDCC::IR
    //
    Core::Integ &Type_Fixed::clamp(Core::Integ &value)
    {
+      // Most values fit in a long, which avoids allocating bounds.
+      if(bitsF + bitsI < sizeof(long) * CHAR_BIT - 2 &&
+         mpz_fits_slong_p(value.get_mpz_t()))
+      {
+         long valueL = value.get_si(), clampL = valueL;
+         Core::FastU bit = bitsF + bitsI;
+         long max = (1L << bit) - 1;
+
+         if(bitsS)
+         {
+            long min = -max - 1;
+
+            if(satur)
+            {
+                    if(clampL > max) clampL = max;
+               else if(clampL < min) clampL = min;
+            }
+            else if(clampL > max || clampL < min)
+            {
+               clampL = static_cast<long>(
+                  static_cast<unsigned long>(clampL) & ((2UL << bit) - 1));
+
+               if(clampL >> bit & 1)
+                  clampL -= 2L << bit;
+            }
+         }
+         else
+         {
+            if(satur)
+            {
+                    if(clampL > max) clampL = max;
+               else if(clampL < 0)   clampL = 0;
+            }
+            else
+            {
+               clampL &= max;
+            }
+         }
+
+         if(clampL != valueL)
+            value = clampL;
+
+         return value;
+      }
+
       Core::Integ max = 1; max <<= bitsF + bitsI; --max;
 
       if(bitsS)
@@ -86,6 +86,9 @@ namespace GDCC::IR
    class Exp_Tuple;
    class Exp_Unary;
    class Exp_Union;
+   class Flow;
+   class FlowAccess;
+   class FlowSet;
    class Function;
    class Glyph;
    class GlyphData;
@@ -96,6 +99,7 @@ namespace GDCC::IR
    class Program;
    class Space;
    class Statement;
+   class StatementArena;
    class StrEnt;
    class Type;
    class TypeAssoc;
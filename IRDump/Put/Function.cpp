@@ -108,6 +108,8 @@ namespace GDCC::IRDump
       if(fn.alloc)    out << "\n   alloc="    << fn.alloc;
                       out << "\n   ctype="    << fn.ctype;
       if(fn.defin)    out << "\n   defin="    << fn.defin;
+      if(fn.inlineAlways) out << "\n   inlineAlways=" << fn.inlineAlways;
+      if(fn.inlineNever)  out << "\n   inlineNever="  << fn.inlineNever;
       if(fn.label)   {out << "\n   label=";      PutString(out, fn.label);}
                       out << "\n   linka="    << fn.linka;
       if(!fn.localArr.empty())  putLocalArr(out, fn.localArr);
@@ -25,7 +25,9 @@
 #include "Core/Exception.hpp"
 #include "Core/File.hpp"
 #include "Core/Option.hpp"
+#include "Core/Parallel.hpp"
 
+#include "IR/IArchive.hpp"
 #include "IR/OArchive.hpp"
 #include "IR/Program.hpp"
 
@@ -34,6 +36,8 @@
 
 #include "Target/Info.hpp"
 
+#include <sstream>
+
 
 //----------------------------------------------------------------------------|
 // Options                                                                    |
@@ -102,6 +106,7 @@ namespace GDCC::LD
       {
          if(len == 0) {}
 
+         else if(len == 2 && !std::memcmp(str, "gc", 2)) info->gc(prog);
          else if(len == 2 && !std::memcmp(str, "tr", 2)) info->tr(prog);
 
          else if(len == 3 && !std::memcmp(str, "chk", 3)) info->chk(prog);
@@ -183,6 +188,40 @@ namespace GDCC::LD
       }
    }
 
+   //
+   // ProcessJobs
+   //
+   // Each job is run on its own program, which is stored as IR and then
+   // merged into prog in job order. Output is therefore the same regardless
+   // of how many jobs run at once.
+   //
+   void ProcessJobs(IR::Program &prog,
+      std::vector<std::function<void(IR::Program &)>> const &jobs)
+   {
+      std::vector<std::string> data(jobs.size());
+
+      Core::ParallelFor(Core::GetOptions().optJobs, jobs.size(),
+         [&](std::size_t i)
+      {
+         IR::Program jobProg;
+         jobs[i](jobProg);
+
+         std::ostringstream out;
+         IR::OArchive arc{out};
+         arc.putHead();
+         arc << jobProg;
+         arc.putTail();
+         data[i] = out.str();
+      });
+
+      for(auto const &str : data)
+      {
+         std::istringstream in{str};
+         IR::IArchive arc{in};
+         arc >> prog;
+      }
+   }
+
    //
    // PutBytecode
    //
@@ -198,6 +237,7 @@ namespace GDCC::LD
       else
       {
          info->chk(prog);
+         info->gc(prog);
          info->pre(prog);
          info->opt(prog);
          info->tr(prog);
@@ -206,7 +246,11 @@ namespace GDCC::LD
          info->gen(prog);
       }
 
-      info->put(prog, out);
+      std::size_t size;
+      auto data = info->put(prog, size);
+
+      if(size)
+         out.write(data.get(), size);
    }
 
    //
@@ -17,8 +17,10 @@
 
 #include "../Option/Bool.hpp"
 
+#include <functional>
 #include <memory>
 #include <ostream>
+#include <vector>
 
 
 //----------------------------------------------------------------------------|
@@ -42,6 +44,9 @@ namespace GDCC::LD
 
    void Link(IR::Program &prog, char const *outName);
 
+   void ProcessJobs(IR::Program &prog,
+      std::vector<std::function<void(IR::Program &)>> const &jobs);
+
    void PutBytecode(std::ostream &out, IR::Program &prog, BC::Info *info);
    void PutIR(std::ostream &out, IR::Program &prog, BC::Info *info);
 }
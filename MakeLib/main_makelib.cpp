@@ -28,6 +28,13 @@
 #include <iostream>
 
 
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+using Jobs = std::vector<std::function<void(GDCC::IR::Program &)>>;
+
+
 //----------------------------------------------------------------------------|
 // Options                                                                    |
 //
@@ -53,86 +60,92 @@ static GDCC::Option::Bool Progress
 //
 // MakeLib_AS
 //
-static void MakeLib_AS(GDCC::IR::Program &prog, std::string path, char const *name)
+static void MakeLib_AS(Jobs &jobs, std::string path, char const *name)
 {
    GDCC::Core::PathAppend(path, name);
 
-   if(Progress)
-      std::cerr << "gdcc-as " << path << std::endl;
+   jobs.emplace_back([path](GDCC::IR::Program &prog)
+   {
+      if(Progress)
+         std::cerr << "gdcc-as " + path + '\n' << std::flush;
 
-   GDCC::AS::ParseFile(path.data(), prog);
+      GDCC::AS::ParseFile(path.data(), prog);
+   });
 }
 
 //
 // MakeLib_CC
 //
-static void MakeLib_CC(GDCC::IR::Program &prog, std::string path, char const *name)
+static void MakeLib_CC(Jobs &jobs, std::string path, char const *name)
 {
    GDCC::Core::PathAppend(path, name);
 
-   if(Progress)
-      std::cerr << "gdcc-cc " << path << std::endl;
+   jobs.emplace_back([path](GDCC::IR::Program &prog)
+   {
+      if(Progress)
+         std::cerr << "gdcc-cc " + path + '\n' << std::flush;
 
-   GDCC::CC::ParseFile(path.data(), prog);
+      GDCC::CC::ParseFile(path.data(), prog);
+   });
 }
 
 //
 // MakeLib_libGDCC
 //
-static void MakeLib_libGDCC(GDCC::IR::Program &prog)
+static void MakeLib_libGDCC(Jobs &jobs)
 {
    std::string path = GDCC::Core::GetOptionLibPath();
    GDCC::Core::PathAppend(path, "src");
    GDCC::Core::PathAppend(path, "libGDCC");
 
-   MakeLib_CC(prog, path, "alloc.c");
+   MakeLib_CC(jobs, path, "alloc.c");
 }
 
 //
 // MakeLib_libacs
 //
-static void MakeLib_libacs(GDCC::IR::Program &)
+static void MakeLib_libacs(Jobs &)
 {
 }
 
 //
 // MakeLib_libc
 //
-static void MakeLib_libc(GDCC::IR::Program &prog, bool nomath = false)
+static void MakeLib_libc(Jobs &jobs, bool nomath = false)
 {
    std::string path = GDCC::Core::GetOptionLibPath();
    GDCC::Core::PathAppend(path, "src");
    GDCC::Core::PathAppend(path, "libc");
 
-   MakeLib_CC(prog, path, "ctype.c");
-   MakeLib_CC(prog, path, "errno.c");
-   MakeLib_CC(prog, path, "fenv.c");
-   MakeLib_CC(prog, path, "fmemopen.c");
-   MakeLib_CC(prog, path, "fopen.c");
-   MakeLib_CC(prog, path, "format.c");
-   MakeLib_CC(prog, path, "formatf.c");
-   MakeLib_AS(prog, path, "fpclassify.asm");
-   MakeLib_CC(prog, path, "locale.c");
-   MakeLib_CC(prog, path, "printf.c");
-   MakeLib_CC(prog, path, "scanf.c");
-   MakeLib_CC(prog, path, "setjmp.c");
-   MakeLib_CC(prog, path, "signal.c");
-   MakeLib_CC(prog, path, "sort.c");
-   MakeLib_CC(prog, path, "stdfix.c");
-   MakeLib_CC(prog, path, "stdio.c");
-   MakeLib_CC(prog, path, "stdlib.c");
-   MakeLib_CC(prog, path, "string.c");
-   MakeLib_CC(prog, path, "strto.c");
-   MakeLib_CC(prog, path, "time.c");
-   MakeLib_CC(prog, path, "wchar.c");
+   MakeLib_CC(jobs, path, "ctype.c");
+   MakeLib_CC(jobs, path, "errno.c");
+   MakeLib_CC(jobs, path, "fenv.c");
+   MakeLib_CC(jobs, path, "fmemopen.c");
+   MakeLib_CC(jobs, path, "fopen.c");
+   MakeLib_CC(jobs, path, "format.c");
+   MakeLib_CC(jobs, path, "formatf.c");
+   MakeLib_AS(jobs, path, "fpclassify.asm");
+   MakeLib_CC(jobs, path, "locale.c");
+   MakeLib_CC(jobs, path, "printf.c");
+   MakeLib_CC(jobs, path, "scanf.c");
+   MakeLib_CC(jobs, path, "setjmp.c");
+   MakeLib_CC(jobs, path, "signal.c");
+   MakeLib_CC(jobs, path, "sort.c");
+   MakeLib_CC(jobs, path, "stdfix.c");
+   MakeLib_CC(jobs, path, "stdio.c");
+   MakeLib_CC(jobs, path, "stdlib.c");
+   MakeLib_CC(jobs, path, "string.c");
+   MakeLib_CC(jobs, path, "strto.c");
+   MakeLib_CC(jobs, path, "time.c");
+   MakeLib_CC(jobs, path, "wchar.c");
 
    if(!nomath)
    {
-      MakeLib_AS(prog, path, "approx.asm");
-      MakeLib_CC(prog, path, "exp.c");
-      MakeLib_CC(prog, path, "math.c");
-      MakeLib_CC(prog, path, "round.c");
-      MakeLib_CC(prog, path, "trig.c");
+      MakeLib_AS(jobs, path, "approx.asm");
+      MakeLib_CC(jobs, path, "exp.c");
+      MakeLib_CC(jobs, path, "math.c");
+      MakeLib_CC(jobs, path, "round.c");
+      MakeLib_CC(jobs, path, "trig.c");
    }
 }
 
@@ -142,13 +155,14 @@ static void MakeLib_libc(GDCC::IR::Program &prog, bool nomath = false)
 static void MakeLib()
 {
    GDCC::IR::Program prog;
+   Jobs              jobs;
 
    for(auto const &arg : GDCC::Core::GetOptionArgs())
    {
-           if(!strcmp(arg, "libGDCC"))     MakeLib_libGDCC(prog);
-      else if(!strcmp(arg, "libacs"))      MakeLib_libacs(prog);
-      else if(!strcmp(arg, "libc"))        MakeLib_libc(prog);
-      else if(!strcmp(arg, "libc-nomath")) MakeLib_libc(prog, true);
+           if(!strcmp(arg, "libGDCC"))     MakeLib_libGDCC(jobs);
+      else if(!strcmp(arg, "libacs"))      MakeLib_libacs(jobs);
+      else if(!strcmp(arg, "libc"))        MakeLib_libc(jobs);
+      else if(!strcmp(arg, "libc-nomath")) MakeLib_libc(jobs, true);
       else
       {
          std::cerr << "ERROR: unknown library: '" << arg << "'\n";
@@ -156,6 +170,9 @@ static void MakeLib()
       }
    }
 
+   // Compile sources.
+   GDCC::LD::ProcessJobs(prog, jobs);
+
    // Write output.
    GDCC::LD::Link(prog, GDCC::Core::GetOptionOutput());
 }
@@ -186,6 +203,7 @@ int main(int argc, char *argv[])
       "\n"
       "Output defaults to last loose argument.";
 
+   opts.optJobs.insert(&opts.list);
    opts.optLibPath.insert(&opts.list);
 
    try
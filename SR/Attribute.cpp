@@ -48,11 +48,13 @@ namespace GDCC::SR
 
       declAuto{false},
 
-      funcDelay      {false},
-      funcInline     {false},
-      funcNoInitDelay{false},
-      funcNoParam    {false},
-      funcNoReturn   {false},
+      funcDelay       {false},
+      funcInline      {false},
+      funcInlineAlways{false},
+      funcInlineNever {false},
+      funcNoInitDelay {false},
+      funcNoParam     {false},
+      funcNoReturn    {false},
 
       isTypedef{false},
 
@@ -62,11 +62,13 @@ namespace GDCC::SR
 
       bool declAuto : 1;
 
-      bool funcDelay       : 1;
-      bool funcInline      : 1;
-      bool funcNoInitDelay : 1;
-      bool funcNoParam     : 1;
-      bool funcNoReturn    : 1;
+      bool funcDelay        : 1;
+      bool funcInline       : 1;
+      bool funcInlineAlways : 1;
+      bool funcInlineNever  : 1;
+      bool funcNoInitDelay  : 1;
+      bool funcNoParam      : 1;
+      bool funcNoReturn     : 1;
 
       bool isTypedef : 1;
 
@@ -82,6 +82,8 @@ namespace GDCC::SR
       declAuto   {false},
       defin      {false},
       delay      {false},
+      inlAlways  {false},
+      inlNever   {false},
       noInitDelay{false},
       used       {false},
       warnDone   {false},
@@ -168,6 +170,9 @@ namespace GDCC::SR
 
       fn.defin    = defin;
 
+      fn.inlineAlways = inlAlways;
+      fn.inlineNever  = inlNever;
+
       // Special rules for certain calling conventions.
 
       // Extra parameter for stack pointer.
@@ -90,6 +90,8 @@ namespace GDCC::SR
       bool           declAuto    : 1;
       bool           defin       : 1;
       bool           delay       : 1;
+      bool           inlAlways   : 1;
+      bool           inlNever    : 1;
       bool           noInitDelay : 1;
       bool           used        : 1;
       bool           warnDone    : 1;
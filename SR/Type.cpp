@@ -63,11 +63,16 @@ namespace GDCC::SR
    //
    Type::Type(Type const &type) : Super{type}, quals{IR::AddrBase::Gen},
       qualNone{type.qualNone},
-      qualNext{type.qualNext}, qualPrev{qualNext->qualPrev},
+      qualNext{type.qualNext}, qualPrev{nullptr},
       arrType{nullptr}, arrType0{nullptr}, avmType{nullptr},
       avmType0{nullptr}, bitType{nullptr}, funType{nullptr},
       lvrType{nullptr}, ptrType{nullptr}, rvrType{nullptr}
    {
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
+      // The list may change until the lock is held.
+      qualPrev = qualNext->qualPrev;
+
       qualNext->qualPrev = this;
       qualPrev->qualNext = this;
    }
@@ -77,6 +82,8 @@ namespace GDCC::SR
    //
    Type::~Type()
    {
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       qualNext->qualPrev = qualPrev;
       qualPrev->qualNext = qualNext;
    }
@@ -88,8 +95,14 @@ namespace GDCC::SR
    {
       if(quals == newQuals) return static_cast<CRef>(this);
 
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
+      // Types being destroyed by another thread may still be in the list.
       for(auto type = qualNext; type != this; type = type->qualNext)
-         if(type->quals == newQuals) return static_cast<CRef>(type);
+      {
+         if(type->quals == newQuals)
+            if(auto ref = TryRef(type)) return static_cast<CRef>(ref);
+      }
 
       auto type = clone();
       type->quals = newQuals;
@@ -162,6 +175,16 @@ namespace GDCC::SR
       throw TypeError();
    }
 
+   //
+   // Type::GetMutex
+   //
+   std::recursive_mutex &Type::GetMutex()
+   {
+      // Never destroyed, as types may outlive any static object.
+      static auto *mutex = new std::recursive_mutex;
+      return *mutex;
+   }
+
    //
    // TypeSet constructor
    //
@@ -177,6 +200,8 @@ namespace GDCC::SR
       Type::CRef const *tend_, bool varia_) : next{head}, prev{head->prev},
       tbeg{tbeg_}, tend{tend_}, varia{varia_}
    {
+      std::lock_guard<std::recursive_mutex> lock{Type::GetMutex()};
+
       next->prev = this;
       prev->next = this;
    }
@@ -186,6 +211,8 @@ namespace GDCC::SR
    //
    TypeSet::~TypeSet()
    {
+      std::lock_guard<std::recursive_mutex> lock{Type::GetMutex()};
+
       next->prev = prev;
       prev->next = next;
 
@@ -208,10 +235,12 @@ namespace GDCC::SR
       TypeSet *head = varia ? HeadV : Head;
       if(!typec) return static_cast<CRef>(head);
 
+      std::lock_guard<std::recursive_mutex> lock{Type::GetMutex()};
+
       for(auto set = head->next; set != head; set = set->next)
       {
          if(set->size() == typec && std::equal(set->begin(), set->end(), typev))
-            return static_cast<CRef>(set);
+            if(auto ref = TryRef(set)) return static_cast<CRef>(ref);
       }
 
       auto tbeg = Core::Array<Type::CRef>::Cpy(typev, typev + typec);
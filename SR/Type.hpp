@@ -20,6 +20,8 @@
 
 #include "../Target/Addr.hpp"
 
+#include <mutex>
+
 
 //----------------------------------------------------------------------------|
 // Macros                                                                     |
@@ -290,6 +292,10 @@ namespace GDCC::SR
       static CRef GetStrEnt();
       static CRef GetVoid();
 
+      // Guards the derived and qualified type caches, which are shared by all
+      // threads.
+      static std::recursive_mutex &GetMutex();
+
       static CRef const Label;
       static CRef const None;
       static CRef const Size;
@@ -31,8 +31,10 @@ namespace GDCC::SR
    //
    Type::CRef Type::getTypeArray() const
    {
-      if(!arrType0) new Type_Array0(this);
-      return static_cast<CRef>(arrType0);
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
+      if(auto type = TryRef(arrType0)) return static_cast<CRef>(type);
+      return static_cast<CRef>(new Type_Array0(this));
    }
 
    //
@@ -40,11 +42,13 @@ namespace GDCC::SR
    //
    Type::CRef Type::getTypeArray(Core::FastU size) const
    {
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       // Search for existing array type.
       if(auto type = arrType) do
       {
          if(type->size == size)
-            return static_cast<CRef>(type);
+            if(auto ref = TryRef(type)) return static_cast<CRef>(ref);
 
          type = type->arrNext;
       }
@@ -61,8 +65,10 @@ namespace GDCC::SR
    {
       if(!size)
       {
-         if(!avmType0) new Type_ArrVM0(this);
-         return static_cast<CRef>(avmType0);
+         std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
+         if(auto type = TryRef(avmType0)) return static_cast<CRef>(type);
+         return static_cast<CRef>(new Type_ArrVM0(this));
       }
 
       // A check for size being a constant expression could go here. However,
@@ -70,10 +76,12 @@ namespace GDCC::SR
 
       // Search for existing array type.
       // This is unlikely to succeed. Do it anyway.
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       if(auto type = avmType) do
       {
          if(type->size == size)
-            return static_cast<CRef>(type);
+            if(auto ref = TryRef(type)) return static_cast<CRef>(ref);
 
          type = type->avmNext;
       }
@@ -113,6 +121,8 @@ namespace GDCC::SR
    //
    Type_ArrVM::~Type_ArrVM()
    {
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       GDCC_SR_Type_Unlink(avm);
    }
 
@@ -175,6 +185,8 @@ namespace GDCC::SR
    //
    Type_ArrVM0::~Type_ArrVM0()
    {
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       // Only nullify base's reference if this is the unqualified pointer.
       if(base->avmType0 == this)
          base->avmType0 = nullptr;
@@ -219,6 +231,8 @@ namespace GDCC::SR
    //
    Type_Array::~Type_Array()
    {
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       GDCC_SR_Type_Unlink(arr);
    }
 
@@ -334,6 +348,8 @@ namespace GDCC::SR
    //
    Type_Array0::~Type_Array0()
    {
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       // Only nullify base's reference if this is the unqualified pointer.
       if(base->arrType0 == this)
          base->arrType0 = nullptr;
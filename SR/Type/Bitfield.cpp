@@ -27,11 +27,13 @@ namespace GDCC::SR
    Type::CRef Type::getTypeBitfield(Core::FastU bitsF, Core::FastU bitsI,
       Core::FastU bitsO) const
    {
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       // Search for existing bitfield type.
       if(auto type = bitType) do
       {
          if(type->bitsF == bitsF && type->bitsI == bitsI && type->bitsO == bitsO)
-            return static_cast<CRef>(type);
+            if(auto ref = TryRef(type)) return static_cast<CRef>(ref);
 
          type = type->bitNext;
       }
@@ -65,6 +67,8 @@ namespace GDCC::SR
    //
    Type_Bitfield::~Type_Bitfield()
    {
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       GDCC_SR_Type_Unlink(bit);
    }
 
@@ -24,11 +24,13 @@ namespace GDCC::SR
    //
    Type::CRef Type::getTypeFunction(TypeSet const *param, IR::CallType ctype) const
    {
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       // Search for existing function type.
       if(auto type = funType) do
       {
          if(type->param == param && type->ctype == ctype)
-            return static_cast<CRef>(type);
+            if(auto ref = TryRef(type)) return static_cast<CRef>(ref);
 
          type = type->funNext;
       }
@@ -61,6 +63,8 @@ namespace GDCC::SR
    //
    Type_Function::~Type_Function()
    {
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       GDCC_SR_Type_Unlink(fun);
    }
 
@@ -29,8 +29,10 @@ namespace GDCC::SR
    //
    Type::CRef Type::getTypePointer() const
    {
-      if(!ptrType) new Type_Pointer(this);
-      return static_cast<CRef>(ptrType);
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
+      if(auto type = TryRef(ptrType)) return static_cast<CRef>(type);
+      return static_cast<CRef>(new Type_Pointer(this));
    }
 
    //
@@ -38,8 +40,10 @@ namespace GDCC::SR
    //
    Type::CRef Type::getTypeRefL() const
    {
-      if(!lvrType) new Type_RefL(this);
-      return static_cast<CRef>(lvrType);
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
+      if(auto type = TryRef(lvrType)) return static_cast<CRef>(type);
+      return static_cast<CRef>(new Type_RefL(this));
    }
 
    //
@@ -47,8 +51,10 @@ namespace GDCC::SR
    //
    Type::CRef Type::getTypeRefR() const
    {
-      if(!rvrType) new Type_RefR(this);
-      return static_cast<CRef>(rvrType);
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
+      if(auto type = TryRef(rvrType)) return static_cast<CRef>(type);
+      return static_cast<CRef>(new Type_RefR(this));
    }
 
    //
@@ -171,6 +177,8 @@ namespace GDCC::SR
    //
    Type_Pointer::~Type_Pointer()
    {
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       // Only nullify base's reference if this is the unqualified pointer.
       if(base->ptrType == this)
          base->ptrType = nullptr;
@@ -189,6 +197,8 @@ namespace GDCC::SR
    //
    Type_RefL::~Type_RefL()
    {
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       // Only nullify base's reference if this is the unqualified pointer.
       if(base->lvrType == this)
          base->lvrType = nullptr;
@@ -207,6 +217,8 @@ namespace GDCC::SR
    //
    Type_RefR::~Type_RefR()
    {
+      std::lock_guard<std::recursive_mutex> lock{GetMutex()};
+
       // Only nullify base's reference if this is the unqualified pointer.
       if(base->rvrType == this)
          base->rvrType = nullptr;
@@ -0,0 +1,45 @@
+##-----------------------------------------------------------------------------
+##
+## Copyright (C) 2025 David Hill
+##
+## See COPYING for license information.
+##
+##-----------------------------------------------------------------------------
+##
+## Compiles SOURCE, runs the IR optimizer on it, and checks that the dump
+## contains the contents of EXPECT. Register packing is disabled so that
+## registers keep their names.
+##
+##-----------------------------------------------------------------------------
+
+execute_process(
+   COMMAND ${GDCC_CC} --target-engine ZDoom ${SOURCE} -c -o ${OUTPUT}.ir
+   RESULT_VARIABLE result)
+if(result)
+   message(FATAL_ERROR "gdcc-cc failed: ${result}")
+endif()
+
+execute_process(
+   COMMAND ${GDCC_LD} --target-engine ZDoom --no-bc-opt-local-reg
+      --ir-process chk:opt ${OUTPUT}.ir -c -o ${OUTPUT}.opt.ir
+   RESULT_VARIABLE result)
+if(result)
+   message(FATAL_ERROR "gdcc-ld failed: ${result}")
+endif()
+
+execute_process(
+   COMMAND ${GDCC_IRDUMP} --dump-function --dump-block ${OUTPUT}.opt.ir
+   OUTPUT_VARIABLE dump
+   RESULT_VARIABLE result)
+if(result)
+   message(FATAL_ERROR "gdcc-irdump failed: ${result}")
+endif()
+
+file(READ ${EXPECT} expect)
+string(FIND "${dump}" "${expect}" found)
+if(found EQUAL -1)
+   message(FATAL_ERROR "expected:\n${expect}\ngot:\n${dump}")
+endif()
+
+## EOF
+
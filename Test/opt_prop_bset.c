@@ -0,0 +1,21 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2025 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Bset only writes part of a register. The read of u.i must not be
+// replaced by the literal stored before it.
+//
+//-----------------------------------------------------------------------------
+
+int f(int v)
+{
+   union {int i; struct {int a:4;} s;} u;
+   u.i = 0; u.s.a = v; return u.i;
+}
+
+// EOF
+
@@ -0,0 +1,23 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2025 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// s is changed by Bset after being copied to t. The read of t.a must not
+// be replaced by a read of s.
+//
+//-----------------------------------------------------------------------------
+
+struct S {int a:4;};
+
+int g(int v)
+{
+   struct S s = {0}, t;
+   s.a = v; t = s; s.a = 5; return t.a;
+}
+
+// EOF
+